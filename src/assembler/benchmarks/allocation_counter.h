@@ -0,0 +1,9 @@
+#ifndef INC_8008_ASSEMBLER_ALLOCATION_COUNTER_H
+#define INC_8008_ASSEMBLER_ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+// The number of calls to the global operator new since the start of the benchmarks.
+std::size_t get_allocation_count();
+
+#endif //INC_8008_ASSEMBLER_ALLOCATION_COUNTER_H
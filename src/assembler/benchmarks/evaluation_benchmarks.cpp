@@ -0,0 +1,96 @@
+#include "allocation_counter.h"
+#include "context.h"
+#include "evaluation/evaluate.h"
+#include "evaluation/evaluator.h"
+#include "evaluation/legacy_evaluate.h"
+#include "evaluation/string_to_int.h"
+#include "options.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string_view>
+
+namespace
+{
+    void define_symbols(Context& context)
+    {
+        context.define_symbol("START", 0x100);
+        context.define_symbol("value", 42);
+        context.define_symbol("label", 0x200);
+        context.define_symbol("addr", 0x1234);
+    }
+
+    void evaluate_new(benchmark::State& state, std::string_view expression)
+    {
+        Options options;
+        Context context{options};
+        define_symbols(context);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(evaluate(context, expression));
+        }
+    }
+
+    // Fails when an evaluation allocates, and reports the allocations per evaluation.
+    void evaluate_without_allocation(benchmark::State& state, std::string_view expression)
+    {
+        Options options;
+        Context context{options};
+        define_symbols(context);
+
+        const auto allocations_before = get_allocation_count();
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(evaluate_argument(context, expression));
+        }
+        const auto allocations = get_allocation_count() - allocations_before;
+
+        state.counters["allocations"] = benchmark::Counter(
+                static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+        if (allocations != 0)
+        {
+            state.SkipWithError("the evaluation allocates");
+        }
+    }
+
+    void read_number(benchmark::State& state, std::string_view number)
+    {
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(string_to_int(number, EvaluationFlags::None));
+        }
+    }
+
+    void evaluate_legacy(benchmark::State& state, std::string_view expression)
+    {
+        Options options;
+        options.legacy_evaluator = true;
+        Context context{options};
+        define_symbols(context);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(legacy_evaluator(context, expression));
+        }
+    }
+}
+
+BENCHMARK_CAPTURE(evaluate_new, number, "1234");
+BENCHMARK_CAPTURE(evaluate_new, hexadecimal, "0x1234");
+BENCHMARK_CAPTURE(evaluate_new, symbol, "START");
+BENCHMARK_CAPTURE(evaluate_new, expression, "(START+value)*2-1");
+BENCHMARK_CAPTURE(evaluate_new, function, "square(value)+1");
+
+BENCHMARK_CAPTURE(evaluate_without_allocation, symbol_offset, "label+2");
+BENCHMARK_CAPTURE(evaluate_without_allocation, high_byte, "H(addr)");
+BENCHMARK_CAPTURE(evaluate_without_allocation, character, "'A'+0x80");
+BENCHMARK_CAPTURE(evaluate_without_allocation, nested, "-((label+2)*(value-1))/3");
+
+BENCHMARK_CAPTURE(read_number, decimal, "1234");
+BENCHMARK_CAPTURE(read_number, hexadecimal_prefix, "0x1234");
+BENCHMARK_CAPTURE(read_number, hexadecimal_suffix, "0FFh");
+BENCHMARK_CAPTURE(read_number, character, "'A'");
+
+BENCHMARK_CAPTURE(evaluate_legacy, number, "1234");
+BENCHMARK_CAPTURE(evaluate_legacy, hexadecimal, "0x1234");
+BENCHMARK_CAPTURE(evaluate_legacy, symbol, "START");
+BENCHMARK_CAPTURE(evaluate_legacy, expression, "START+value*2-1");
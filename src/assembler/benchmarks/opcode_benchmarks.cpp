@@ -0,0 +1,51 @@
+#include "instruction.h"
+#include "opcodes/opcodes.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Finds an opcode the way an instruction does: classified, then decoded.
+    void find_opcode(benchmark::State& state, SyntaxType syntax, std::string_view mnemonic,
+                     std::vector<std::string_view> arguments)
+    {
+        for (auto _ : state)
+        {
+            const auto kind = classify_instruction(mnemonic, syntax);
+            if (kind.opcode_index != InstructionKind::NO_OPCODE)
+            {
+                benchmark::DoNotOptimize(
+                        decode_opcode(syntax, kind.opcode_index, mnemonic, arguments));
+            }
+            benchmark::DoNotOptimize(kind);
+        }
+    }
+
+    void classify(benchmark::State& state, SyntaxType syntax, std::string_view opcode)
+    {
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(classify_instruction(opcode, syntax));
+        }
+    }
+}
+
+BENCHMARK_CAPTURE(find_opcode, old_first, OLD, "LAA", {});
+BENCHMARK_CAPTURE(find_opcode, old_immediate, OLD, "LAI", {"0x12"});
+BENCHMARK_CAPTURE(find_opcode, old_jump, OLD, "JMP", {"START"});
+BENCHMARK_CAPTURE(find_opcode, old_last, OLD, "OUT", {"10"});
+BENCHMARK_CAPTURE(find_opcode, old_unknown, OLD, "NOPE", {});
+
+BENCHMARK_CAPTURE(find_opcode, new_register, NEW, "MOV", {"A", "B"});
+BENCHMARK_CAPTURE(find_opcode, new_immediate, NEW, "MVI", {"A", "0x12"});
+BENCHMARK_CAPTURE(find_opcode, new_jump, NEW, "JMP", {"START"});
+BENCHMARK_CAPTURE(find_opcode, new_unknown, NEW, "NOPE", {});
+
+BENCHMARK_CAPTURE(classify, directive, OLD, "ORG");
+BENCHMARK_CAPTURE(classify, macro_call, OLD, ".my_macro");
+BENCHMARK_CAPTURE(classify, old_mnemonic, OLD, "OUT");
+BENCHMARK_CAPTURE(classify, new_mnemonic, NEW, "MVI");
@@ -0,0 +1,61 @@
+#include "byte_writer.h"
+#include "listing.h"
+#include "options.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    constexpr int PROGRAM_SIZE = 4096;
+
+    void write_bytes(benchmark::State& state, ByteWriter::WriteMode mode)
+    {
+        for (auto _ : state)
+        {
+            std::ostringstream output;
+            ByteWriter writer{output, mode};
+            for (int address = 0; address < PROGRAM_SIZE; ++address)
+            {
+                writer.write_byte(address & 0xff, address);
+            }
+            writer.write_end();
+            benchmark::DoNotOptimize(output);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * PROGRAM_SIZE));
+    }
+
+    void write_listing(benchmark::State& state, bool single_byte_list)
+    {
+        Options options;
+        options.single_byte_list = single_byte_list;
+        const std::vector<int> data_list{0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x0a, 0x00};
+
+        for (auto _ : state)
+        {
+            std::ostringstream output;
+            Listing listing{output, options};
+            for (std::uint32_t line_number = 1; line_number <= 100; line_number += 5)
+            {
+                const int address = static_cast<int>(line_number) * 2;
+                listing.simple_line(line_number, "; A comment line");
+                listing.opcode_line_with_space(line_number + 1, address, 0xc0, "        LAA");
+                listing.opcode_line_with_space_1_arg(line_number + 2, address + 1, 0x06, 0x12,
+                                                     "        LAI 0x12");
+                listing.opcode_line_with_space_2_arg(line_number + 3, address + 3, 0x44, 0x00,
+                                                     0x01, "        JMP 0x100");
+                listing.data(line_number + 4, address + 6, "        DATA \"Hello\\n\", 0",
+                             data_list);
+            }
+            benchmark::DoNotOptimize(output);
+        }
+    }
+}
+
+BENCHMARK_CAPTURE(write_bytes, hex, ByteWriter::HEX);
+BENCHMARK_CAPTURE(write_bytes, binary, ByteWriter::BINARY);
+
+BENCHMARK_CAPTURE(write_listing, default, false);
+BENCHMARK_CAPTURE(write_listing, single_byte, true);
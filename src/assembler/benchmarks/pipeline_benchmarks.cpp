@@ -0,0 +1,122 @@
+#include "allocation_counter.h"
+#include "assemble.h"
+#include "context_stack.h"
+#include "files/file_reader.h"
+#include "files/source_buffer.h"
+#include "first_pass.h"
+#include "options.h"
+#include "parsed_line_storage.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+
+namespace
+{
+    // Assembles a whole source in memory, from the tokenization to the listing.
+    void run_assembly(benchmark::State& state, const Options& options, std::string_view name,
+                      std::string_view source)
+    {
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(assemble(options, name, source));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+    }
+
+    void assemble_data_file(benchmark::State& state, std::string_view filename, bool new_syntax)
+    {
+        const std::string path = std::string{ASSEMBLER_BENCHMARK_DATA_DIR} + "/" +
+                                 std::string{filename};
+        const auto source = SourceBuffer::from_file(path);
+        if (!source)
+        {
+            state.SkipWithError(("Cannot open " + path).c_str());
+            return;
+        }
+
+        Options options;
+        options.new_syntax = new_syntax;
+        run_assembly(state, options, filename, source->get_content());
+    }
+
+    // Symbols can't hold digits in expressions, so labels are numbered with letters.
+    std::string make_label(int number)
+    {
+        std::string label = "label_";
+        do
+        {
+            label += static_cast<char>('a' + number % 26);
+            number /= 26;
+        } while (number > 0);
+        return label;
+    }
+
+    // A program with many labels, macro calls and data, in the style of test.asm.
+    std::string make_large_program(int block_count)
+    {
+        std::string program = "LD_IMM: .macro  r1,r2,imm\n"
+                              "        .syntax new\n"
+                              "value:  EQU IMM\n"
+                              "        MVI r1,\\HB\\value\n"
+                              "        MVI r2,\\LB\\value\n"
+                              "        .endmacro\n\n";
+        for (int block = 0; block < block_count; ++block)
+        {
+            const auto label = make_label(block);
+            const auto next_label = make_label((block + 1) % block_count);
+            program += "        ; Block " + std::to_string(block) + "\n";
+            program += label + ":\n";
+            program += "        LAI " + std::to_string(block % 256) + "\n";
+            program += "        LHI \\HB\\" + label + "\n";
+            program += "        LLI \\LB\\" + label + "\n";
+            program += "        .LD_IMM H,L," + label + "\n";
+            program += "        DATA \"text\", " + std::to_string(block % 256) + ", 1\n";
+            program += "        JMP " + next_label + "\n";
+        }
+        program += "        END\n";
+        return program;
+    }
+
+    void assemble_large_program(benchmark::State& state)
+    {
+        const auto source = make_large_program(static_cast<int>(state.range(0)));
+        run_assembly(state, Options{}, "large.asm", source);
+    }
+
+    // Parses the large program, and reports the memory held and the allocations made for each
+    // parsed line.
+    void parse_large_program(benchmark::State& state)
+    {
+        const auto source = make_large_program(static_cast<int>(state.range(0)));
+        const Options options;
+        std::size_t line_count = 0;
+        std::size_t memory_usage = 0;
+        std::size_t allocation_count = 0;
+        for (auto _ : state)
+        {
+            const auto allocations_before = get_allocation_count();
+            FileReader file_reader;
+            file_reader.append(SourceBuffer::from_string(source), "large.asm");
+            ParsedLineStorage parsed_line_storage;
+            first_pass(ContextStack{options}, file_reader, parsed_line_storage);
+
+            line_count = parsed_line_storage.size();
+            memory_usage = parsed_line_storage.get_memory_usage();
+            allocation_count = get_allocation_count() - allocations_before;
+        }
+        state.counters["lines"] = static_cast<double>(line_count);
+        state.counters["bytes_per_line"] =
+                static_cast<double>(memory_usage) / static_cast<double>(line_count);
+        state.counters["allocations_per_line"] =
+                static_cast<double>(allocation_count) / static_cast<double>(line_count);
+    }
+}
+
+BENCHMARK_CAPTURE(assemble_data_file, test, "test.asm", false);
+BENCHMARK_CAPTURE(assemble_data_file, basics, "data/basics.asm", false);
+BENCHMARK_CAPTURE(assemble_data_file, old_syntax, "data/old_syntax.asm", false);
+BENCHMARK_CAPTURE(assemble_data_file, new_syntax, "data/new_syntax.asm", true);
+BENCHMARK(assemble_large_program)->Arg(64)->Arg(512);
+BENCHMARK(parse_large_program)->Arg(512);
@@ -0,0 +1,116 @@
+#include "context.h"
+#include "options.h"
+#include "symbol_table.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<std::string> make_symbol_names(std::size_t count)
+    {
+        std::vector<std::string> names;
+        names.reserve(count);
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            names.push_back("label_" + std::to_string(index));
+        }
+        return names;
+    }
+
+    void define_symbols(benchmark::State& state)
+    {
+        const auto names = make_symbol_names(state.range(0));
+        for (auto _ : state)
+        {
+            SymbolTable table;
+            for (std::size_t index = 0; index < names.size(); ++index)
+            {
+                table.define_symbol(names[index], static_cast<int>(index));
+            }
+            benchmark::DoNotOptimize(table);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * names.size()));
+    }
+
+    void find_symbols(benchmark::State& state)
+    {
+        const auto names = make_symbol_names(state.range(0));
+        SymbolTable table;
+        for (std::size_t index = 0; index < names.size(); ++index)
+        {
+            table.define_symbol(names[index], static_cast<int>(index));
+        }
+
+        for (auto _ : state)
+        {
+            for (const auto& name : names)
+            {
+                benchmark::DoNotOptimize(table.get_symbol_value(name));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * names.size()));
+    }
+
+    void find_symbols_by_id(benchmark::State& state)
+    {
+        const auto names = make_symbol_names(state.range(0));
+        SymbolTable table;
+        std::vector<SymbolTable::SymbolId> ids;
+        for (std::size_t index = 0; index < names.size(); ++index)
+        {
+            table.define_symbol(names[index], static_cast<int>(index));
+            ids.push_back(table.get_interner()->find(names[index]));
+        }
+
+        for (auto _ : state)
+        {
+            for (const auto id : ids)
+            {
+                benchmark::DoNotOptimize(table.get_symbol_value(id));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ids.size()));
+    }
+
+    // A symbol of the top level, referenced from nested contexts.
+    void find_symbol_in_nested_context(benchmark::State& state)
+    {
+        Options options;
+        auto context = std::make_shared<Context>(options);
+        context->define_symbol("START", 0x100);
+        for (int depth = 0; depth < state.range(0); ++depth)
+        {
+            context = std::make_shared<Context>(context);
+        }
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(context->get_symbol_value("start"));
+        }
+    }
+
+    void miss_symbol(benchmark::State& state)
+    {
+        const auto names = make_symbol_names(state.range(0));
+        SymbolTable table;
+        for (std::size_t index = 0; index < names.size(); ++index)
+        {
+            table.define_symbol(names[index], static_cast<int>(index));
+        }
+
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(table.get_symbol_value("undefined_label"));
+        }
+    }
+}
+
+BENCHMARK(define_symbols)->Arg(16)->Arg(1024);
+BENCHMARK(find_symbols)->Arg(16)->Arg(1024);
+BENCHMARK(find_symbols_by_id)->Arg(16)->Arg(1024);
+BENCHMARK(find_symbol_in_nested_context)->Arg(0)->Arg(8)->Arg(64);
+BENCHMARK(miss_symbol)->Arg(16)->Arg(1024);
@@ -0,0 +1,79 @@
+#include "character_classifier.h"
+#include "line_tokenizer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    void tokenize(benchmark::State& state, std::string_view line)
+    {
+        for (auto _ : state)
+        {
+            LineTokenizer tokens{line};
+            benchmark::DoNotOptimize(tokens);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * line.size()));
+    }
+
+    void classify(benchmark::State& state, ClassificationKernel kernel)
+    {
+        std::string text;
+        while (text.size() < 4096)
+        {
+            text += "        DATA \"Hello, world\", 'x', 1, 2 ; a comment\t\n";
+        }
+        text.resize(4096);
+
+        ClassifiedBlock block;
+        for (auto _ : state)
+        {
+            for (std::size_t offset = 0; offset < text.size(); offset += ClassifiedBlock::SIZE)
+            {
+                classify_block(kernel, text.data() + offset, block);
+                benchmark::DoNotOptimize(block);
+            }
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    }
+
+    void classify_with_available_kernel(benchmark::State& state, ClassificationKernel kernel)
+    {
+        const auto kernels = get_available_classification_kernels();
+        if (std::find(std::begin(kernels), std::end(kernels), kernel) == std::end(kernels))
+        {
+            state.SkipWithError("Kernel not available on this processor");
+            return;
+        }
+        classify(state, kernel);
+    }
+
+    // Long comments and data lists, as in sources with tables and documented routines.
+    const std::string comment_heavy_line =
+            "        LAI 0x12 ; " + std::string(120, '-') + " Loads the first value of the table";
+    const std::string data_heavy_line = [] {
+        std::string line = "table:  DATA 0x00";
+        for (int value = 1; value < 48; value += 1)
+        {
+            line += ", " + std::to_string(value);
+        }
+        return line + ", \"end of table\"";
+    }();
+}
+
+BENCHMARK_CAPTURE(tokenize, empty, "");
+BENCHMARK_CAPTURE(tokenize, comment, "; This line is only a comment, as often in sources");
+BENCHMARK_CAPTURE(tokenize, no_argument, "        LAA");
+BENCHMARK_CAPTURE(tokenize, label_and_argument, "start:  LAI 0x12 ; with a comment");
+BENCHMARK_CAPTURE(tokenize, two_arguments, "        MVI A,\\HB\\value");
+BENCHMARK_CAPTURE(tokenize, data,
+                  "        DATA \"Hello, world\\n\", 'x', 1, 2, 3, 0x10, 100o ; text and values");
+BENCHMARK_CAPTURE(tokenize, comment_heavy, comment_heavy_line);
+BENCHMARK_CAPTURE(tokenize, data_heavy, data_heavy_line);
+
+BENCHMARK_CAPTURE(classify_with_available_kernel, scalar, ClassificationKernel::SCALAR);
+BENCHMARK_CAPTURE(classify_with_available_kernel, sse2, ClassificationKernel::SSE2);
+BENCHMARK_CAPTURE(classify_with_available_kernel, avx2, ClassificationKernel::AVX2);
@@ -0,0 +1,87 @@
+#include "assemble.h"
+
+#include "byte_writer.h"
+#include "context.h"
+#include "context_stack.h"
+#include "emission_pass.h"
+#include "files/file_reader.h"
+#include "files/files.h"
+#include "files/source_buffer.h"
+#include "first_pass.h"
+#include "options.h"
+#include "parsed_line_storage.h"
+
+#include <memory>
+#include <sstream>
+
+namespace
+{
+    // Returns the top level context, which holds the symbols of the program.
+    std::shared_ptr<Context> run_passes(const Options& options, FileReader& file_reader,
+                                        ByteWriter& writer, std::ostream& listing_stream)
+    {
+        ParsedLineStorage parsed_line_storage;
+
+        ContextStack context_stack(options);
+        auto top_level_context = context_stack.get_current_context();
+
+        first_pass(context_stack, file_reader, parsed_line_storage);
+        emission_pass(options, writer, listing_stream, parsed_line_storage);
+
+        /* write symbol table to listfile */
+        if (options.generate_list_file)
+        {
+            top_level_context->list_symbols(listing_stream);
+        }
+        return top_level_context;
+    }
+
+    ByteWriter::WriteMode get_write_mode(const Options& options)
+    {
+        return options.generate_binary_file ? ByteWriter::BINARY : ByteWriter::HEX;
+    }
+}
+
+void assemble_files(const Options& options)
+{
+    Files files(options);
+    assemble_to_streams(options, files.file_reader, files.output_stream, files.listing_stream);
+}
+
+void assemble_to_streams(const Options& options, FileReader& file_reader,
+                         std::ostream& output_stream, std::ostream& listing_stream)
+{
+    ByteWriter writer(output_stream, get_write_mode(options));
+    run_passes(options, file_reader, writer, listing_stream);
+}
+
+AssemblyResult assemble(const Options& options, std::string_view source_name,
+                        std::string_view source, const InMemoryFiles& included_files)
+{
+    // The name of the input appears in the listing header.
+    Options source_options{options};
+    source_options.input_filenames = {std::string{source_name}};
+
+    FileReader file_reader;
+    file_reader.append(SourceBuffer::from_string(std::string{source}), source_name);
+    file_reader.set_include_resolver(
+            [&included_files](const std::string& filename) -> std::shared_ptr<const SourceBuffer> {
+                auto it = included_files.find(filename);
+                if (it == std::end(included_files))
+                {
+                    return nullptr;
+                }
+                return SourceBuffer::from_string(it->second);
+            });
+
+    std::ostringstream output_stream;
+    std::ostringstream listing_stream;
+    ByteWriter writer(output_stream, get_write_mode(source_options));
+    auto top_level_context = run_passes(source_options, file_reader, writer, listing_stream);
+
+    const auto& program_memory = writer.get_program_memory();
+    return {{std::begin(program_memory), std::end(program_memory)},
+            std::move(output_stream).str(),
+            std::move(listing_stream).str(),
+            top_level_context->get_symbol_table().get_symbols()};
+}
@@ -0,0 +1,48 @@
+#ifndef INC_8008_ASSEMBLER_ASSEMBLE_H
+#define INC_8008_ASSEMBLER_ASSEMBLE_H
+
+#include "symbol_table.h"
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class FileReader;
+class Options;
+
+// Assembles the input files of the options into the output file and the listing file.
+// Each call has its own files and contexts, so calls can run in parallel.
+// Throws CannotOpenFile or ParsingException on errors.
+void assemble_files(const Options& options);
+
+// Assembles the sources queued in the file reader into the output and listing streams.
+// The listing stream is only written when the options ask for a listing.
+void assemble_to_streams(const Options& options, FileReader& file_reader,
+                         std::ostream& output_stream, std::ostream& listing_stream);
+
+// Named sources, which can be included by an assembled source.
+using InMemoryFiles = std::map<std::string, std::string, std::less<>>;
+
+struct AssemblyResult
+{
+    // The 16 KiB of the 8008 memory, with the assembled bytes.
+    std::vector<std::uint8_t> memory;
+    // The Intel Hex or binary content, as it would be written in the output file.
+    std::string output;
+    // Empty if the options don't ask for a listing.
+    std::string listing;
+    // The symbols of the program, in their definition order.
+    std::vector<SymbolTable::Symbol> symbols;
+};
+
+// Assembles a source in memory. Included files are taken from the in-memory files,
+// and the filesystem is never accessed. The source name appears in the errors and in
+// the listing. The input files of the options are ignored.
+// Throws CannotOpenFile for missing included files, or ParsingException on errors.
+AssemblyResult assemble(const Options& options, std::string_view source_name,
+                        std::string_view source, const InMemoryFiles& included_files = {});
+
+#endif //INC_8008_ASSEMBLER_ASSEMBLE_H
@@ -0,0 +1,93 @@
+#include "batch.h"
+
+#include "assemble.h"
+#include "errors.h"
+#include "files/files.h"
+#include "files/source_buffer.h"
+#include "thread_pool.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+std::vector<Options> read_batch_jobs(const Options& options)
+{
+    const auto source = SourceBuffer::from_file(options.batch_filename);
+    if (!source)
+    {
+        throw CannotOpenFile(options.batch_filename, "batch file");
+    }
+
+    std::vector<Options> jobs;
+    LineSplitter splitter{source->get_content()};
+    std::string_view line;
+    std::size_t line_number = 0;
+    while (splitter.next_line(line))
+    {
+        line_number += 1;
+        line = trim_string(line);
+        if (line.empty() || line.front() == ';' || line.front() == '#')
+        {
+            continue;
+        }
+
+        Options job{options};
+        try
+        {
+            job.parse_batch_job(line);
+        }
+        catch (InvalidCommandLine&)
+        {
+            std::cerr << "invalid job in line " << line_number << " of "
+                      << options.batch_filename << std::endl;
+            throw;
+        }
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+std::size_t assemble_batch(const std::vector<Options>& jobs, std::size_t thread_count)
+{
+    // The output of verbose and debug jobs would be mixed with the others.
+    const bool has_output = std::ranges::any_of(
+            jobs, [](const auto& job) { return job.verbose || job.debug; });
+    ThreadPool thread_pool{has_output ? 1 : thread_count};
+
+    std::vector<std::string> errors(jobs.size());
+    std::vector<ThreadPool::Task> tasks;
+    tasks.reserve(jobs.size());
+    for (std::size_t index = 0; index < jobs.size(); index += 1)
+    {
+        tasks.emplace_back([&job = jobs[index], &error = errors[index]] {
+            // The jobs already share the threads, so each one builds its lines alone.
+            Options job_options{job};
+            job_options.thread_count = 1;
+            try
+            {
+                assemble_files(job_options);
+            }
+            catch (const CannotOpenFile& ex)
+            {
+                error = ex.what();
+            }
+            catch (const std::exception& ex)
+            {
+                error = std::string{"Error: "} + ex.what();
+            }
+        });
+    }
+    thread_pool.run(tasks);
+
+    std::size_t failed_job_count = 0;
+    for (const auto& error : errors)
+    {
+        if (!error.empty())
+        {
+            std::cerr << error << std::endl;
+            failed_job_count += 1;
+        }
+    }
+    return failed_job_count;
+}
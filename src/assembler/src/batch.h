@@ -0,0 +1,19 @@
+#ifndef INC_8008_ASSEMBLER_BATCH_H
+#define INC_8008_ASSEMBLER_BATCH_H
+
+#include "options.h"
+
+#include <cstddef>
+#include <vector>
+
+// Reads the jobs from the batch file of the options. Each line holds the arguments of
+// a job, as on the command line, and the options of the batch are the defaults of each
+// job. Empty lines and lines starting with ';' or '#' are ignored.
+// Throws CannotOpenFile or InvalidCommandLine.
+std::vector<Options> read_batch_jobs(const Options& options);
+
+// Assembles the independent jobs in parallel and reports their errors in the order of
+// the jobs. Returns the number of jobs that failed.
+std::size_t assemble_batch(const std::vector<Options>& jobs, std::size_t thread_count);
+
+#endif //INC_8008_ASSEMBLER_BATCH_H
@@ -15,10 +15,7 @@ namespace
 ByteWriter::ByteWriter(std::ostream& output, ByteWriter::WriteMode mode)
     : output(output), mode(mode)
 {
-    if (mode == BINARY)
-    {
-        program_memory.resize(highest_address);
-    }
+    program_memory.resize(highest_address);
     current_line_content.reserve(MAX_BYTE_ON_LINE);
 }
 
@@ -29,9 +26,12 @@ void ByteWriter::write_byte(int data, int address)
         throw AddressTooHigh(address);
     }
 
-    if (mode == BINARY)
+    if (address >= 0)
     {
         program_memory[address] = (unsigned char) (data & 0xFF);
+    }
+    if (mode == BINARY)
+    {
         return;
     }
 
@@ -87,6 +87,11 @@ void ByteWriter::write_end()
     }
 }
 
+const std::vector<unsigned char>& ByteWriter::get_program_memory() const
+{
+    return program_memory;
+}
+
 AddressTooHigh::AddressTooHigh(int faulty_address)
 {
     reason = "address of data " + std::to_string(faulty_address) + " larger than " +
@@ -21,6 +21,9 @@ public:
     void write_byte(int data, int address);
     void write_end();
 
+    // The memory of the 8008, with all the written bytes, whatever the mode.
+    [[nodiscard]] const std::vector<unsigned char>& get_program_memory() const;
+
 private:
     void flush_hex_line();
 
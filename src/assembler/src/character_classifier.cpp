@@ -0,0 +1,268 @@
+#include "character_classifier.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+// SSE2 is always there on x86-64, but 32-bit x86 only has it when the build enables it. AVX2
+// is compiled for its own functions, and only used when the processor has it.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ASSEMBLER_HAS_SSE2
+#endif
+#if defined(__GNUC__)
+#define ASSEMBLER_HAS_AVX2
+#define ASSEMBLER_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define ASSEMBLER_HAS_AVX2
+#define ASSEMBLER_AVX2_TARGET
+#endif
+#endif
+
+namespace
+{
+    constexpr std::array<unsigned char, 256> make_class_table()
+    {
+        std::array<unsigned char, 256> table{};
+        table[static_cast<unsigned char>(' ')] = CharacterClasses::BLANK;
+        table[static_cast<unsigned char>('\t')] = CharacterClasses::BLANK;
+        table[static_cast<unsigned char>(',')] = CharacterClasses::COMMA;
+        table[static_cast<unsigned char>(';')] = CharacterClasses::SEMICOLON;
+        table[static_cast<unsigned char>('\'')] = CharacterClasses::QUOTE;
+        table[static_cast<unsigned char>('"')] = CharacterClasses::QUOTE;
+        return table;
+    }
+
+    constexpr auto class_table = make_class_table();
+
+    void classify_scalar(const char* data, ClassifiedBlock& block)
+    {
+        block.masks = {};
+        for (std::size_t index = 0; index < ClassifiedBlock::SIZE; index += 1)
+        {
+            const unsigned classes = class_table[static_cast<unsigned char>(data[index])];
+            if (classes == 0)
+            {
+                continue;
+            }
+            for (std::size_t class_index = 0; class_index < CharacterClasses::COUNT;
+                 class_index += 1)
+            {
+                block.masks[class_index] |=
+                        static_cast<std::uint64_t>((classes >> class_index) & 1U) << index;
+            }
+        }
+    }
+
+#ifdef ASSEMBLER_HAS_SSE2
+    std::uint64_t to_mask(__m128i matches, std::size_t offset)
+    {
+        return static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(matches)))
+               << offset;
+    }
+
+    void classify_sse2(const char* data, ClassifiedBlock& block)
+    {
+        const auto space = _mm_set1_epi8(' ');
+        const auto tab = _mm_set1_epi8('\t');
+        const auto comma = _mm_set1_epi8(',');
+        const auto semicolon = _mm_set1_epi8(';');
+        const auto single_quote = _mm_set1_epi8('\'');
+        const auto double_quote = _mm_set1_epi8('"');
+
+        block.masks = {};
+        for (std::size_t offset = 0; offset < ClassifiedBlock::SIZE; offset += 16)
+        {
+            const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+
+            block.masks[0] |= to_mask(
+                    _mm_or_si128(_mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab)),
+                    offset);
+            block.masks[1] |= to_mask(_mm_cmpeq_epi8(chars, comma), offset);
+            block.masks[2] |= to_mask(_mm_cmpeq_epi8(chars, semicolon), offset);
+            block.masks[3] |= to_mask(_mm_or_si128(_mm_cmpeq_epi8(chars, single_quote),
+                                                   _mm_cmpeq_epi8(chars, double_quote)),
+                                      offset);
+        }
+    }
+#endif
+
+#ifdef ASSEMBLER_HAS_AVX2
+    ASSEMBLER_AVX2_TARGET std::uint64_t to_mask(__m256i matches, std::size_t offset)
+    {
+        return static_cast<std::uint64_t>(
+                       static_cast<std::uint32_t>(_mm256_movemask_epi8(matches)))
+               << offset;
+    }
+
+    ASSEMBLER_AVX2_TARGET void classify_avx2(const char* data, ClassifiedBlock& block)
+    {
+        const auto space = _mm256_set1_epi8(' ');
+        const auto tab = _mm256_set1_epi8('\t');
+        const auto comma = _mm256_set1_epi8(',');
+        const auto semicolon = _mm256_set1_epi8(';');
+        const auto single_quote = _mm256_set1_epi8('\'');
+        const auto double_quote = _mm256_set1_epi8('"');
+
+        block.masks = {};
+        for (std::size_t offset = 0; offset < ClassifiedBlock::SIZE; offset += 32)
+        {
+            const auto chars =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+
+            block.masks[0] |= to_mask(_mm256_or_si256(_mm256_cmpeq_epi8(chars, space),
+                                                      _mm256_cmpeq_epi8(chars, tab)),
+                                      offset);
+            block.masks[1] |= to_mask(_mm256_cmpeq_epi8(chars, comma), offset);
+            block.masks[2] |= to_mask(_mm256_cmpeq_epi8(chars, semicolon), offset);
+            block.masks[3] |= to_mask(_mm256_or_si256(_mm256_cmpeq_epi8(chars, single_quote),
+                                                      _mm256_cmpeq_epi8(chars, double_quote)),
+                                      offset);
+        }
+    }
+
+    bool has_avx2()
+    {
+#if defined(__GNUC__)
+        return __builtin_cpu_supports("avx2");
+#else
+        return true;
+#endif
+    }
+#endif
+
+    ClassificationKernel find_fastest_kernel()
+    {
+        return get_available_classification_kernels().back();
+    }
+}
+
+std::uint64_t ClassifiedBlock::get_mask(unsigned classes) const
+{
+    std::uint64_t mask = 0;
+    for (std::size_t class_index = 0; class_index < CharacterClasses::COUNT; class_index += 1)
+    {
+        if ((classes >> class_index) & 1U)
+        {
+            mask |= masks[class_index];
+        }
+    }
+    return mask;
+}
+
+std::vector<ClassificationKernel> get_available_classification_kernels()
+{
+    std::vector<ClassificationKernel> kernels{ClassificationKernel::SCALAR};
+#ifdef ASSEMBLER_HAS_SSE2
+    kernels.push_back(ClassificationKernel::SSE2);
+#endif
+#ifdef ASSEMBLER_HAS_AVX2
+    if (has_avx2())
+    {
+        kernels.push_back(ClassificationKernel::AVX2);
+    }
+#endif
+    return kernels;
+}
+
+void classify_block(ClassificationKernel kernel, const char* data, ClassifiedBlock& block)
+{
+    switch (kernel)
+    {
+#ifdef ASSEMBLER_HAS_AVX2
+        case ClassificationKernel::AVX2:
+            classify_avx2(data, block);
+            return;
+#endif
+#ifdef ASSEMBLER_HAS_SSE2
+        case ClassificationKernel::SSE2:
+            classify_sse2(data, block);
+            return;
+#endif
+        default:
+            classify_scalar(data, block);
+    }
+}
+
+void classify_block(const char* data, ClassifiedBlock& block)
+{
+    static const ClassificationKernel fastest_kernel = find_fastest_kernel();
+    classify_block(fastest_kernel, data, block);
+}
+
+CharacterClassifier::CharacterClassifier(std::string_view text) : text{text} {}
+
+std::size_t CharacterClassifier::find_first_of(std::size_t position, unsigned classes)
+{
+    for (auto block_index = position / ClassifiedBlock::SIZE; block_index < get_block_count();
+         block_index += 1)
+    {
+        const auto mask =
+                get_block(block_index).get_mask(classes) & get_valid_mask(block_index, position);
+        if (mask != 0)
+        {
+            return block_index * ClassifiedBlock::SIZE + std::countr_zero(mask);
+        }
+    }
+    return std::string_view::npos;
+}
+
+std::size_t CharacterClassifier::find_first_not_of(std::size_t position, unsigned classes)
+{
+    for (auto block_index = position / ClassifiedBlock::SIZE; block_index < get_block_count();
+         block_index += 1)
+    {
+        const auto mask =
+                ~get_block(block_index).get_mask(classes) & get_valid_mask(block_index, position);
+        if (mask != 0)
+        {
+            return block_index * ClassifiedBlock::SIZE + std::countr_zero(mask);
+        }
+    }
+    return std::string_view::npos;
+}
+
+const ClassifiedBlock& CharacterClassifier::get_block(std::size_t block_index)
+{
+    while (blocks.size() <= block_index)
+    {
+        const auto block_start = blocks.size() * ClassifiedBlock::SIZE;
+        ClassifiedBlock block;
+        if (text.size() - block_start >= ClassifiedBlock::SIZE)
+        {
+            classify_block(text.data() + block_start, block);
+        }
+        else
+        {
+            // The last block is padded with null characters, which are in no class.
+            char padded_block[ClassifiedBlock::SIZE]{};
+            std::memcpy(padded_block, text.data() + block_start, text.size() - block_start);
+            classify_block(padded_block, block);
+        }
+        blocks.push_back(block);
+    }
+    return blocks[block_index];
+}
+
+std::size_t CharacterClassifier::get_block_count() const
+{
+    return (text.size() + ClassifiedBlock::SIZE - 1) / ClassifiedBlock::SIZE;
+}
+
+std::uint64_t CharacterClassifier::get_valid_mask(std::size_t block_index,
+                                                  std::size_t position) const
+{
+    // Only the characters of the text, from the position, are searched.
+    const auto block_start = block_index * ClassifiedBlock::SIZE;
+    std::uint64_t mask = ~std::uint64_t{0};
+    if (position > block_start)
+    {
+        mask <<= position - block_start;
+    }
+    const auto remaining = text.size() - block_start;
+    if (remaining < ClassifiedBlock::SIZE)
+    {
+        mask &= (std::uint64_t{1} << remaining) - 1;
+    }
+    return mask;
+}
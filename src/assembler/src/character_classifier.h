@@ -0,0 +1,77 @@
+#ifndef INC_8008_ASSEMBLER_CHARACTER_CLASSIFIER_H
+#define INC_8008_ASSEMBLER_CHARACTER_CLASSIFIER_H
+
+#include "small_vector.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// The characters searched by the tokenizer, as bits of a mask.
+struct CharacterClasses
+{
+    static constexpr unsigned BLANK = 1U << 0U; // ' ' and '\t'
+    static constexpr unsigned COMMA = 1U << 1U;
+    static constexpr unsigned SEMICOLON = 1U << 2U;
+    static constexpr unsigned QUOTE = 1U << 3U; // '\'' and '"'
+
+    static constexpr std::size_t COUNT = 4;
+};
+
+// The positions of the characters of each class in a block of characters.
+// Bit N of a mask is set when the character N of the block is in the class.
+struct ClassifiedBlock
+{
+    static constexpr std::size_t SIZE = 64;
+
+    std::array<std::uint64_t, CharacterClasses::COUNT> masks{};
+
+    // The positions of the characters in any of the classes.
+    [[nodiscard]] std::uint64_t get_mask(unsigned classes) const;
+};
+
+enum class ClassificationKernel
+{
+    SCALAR,
+    SSE2,
+    AVX2,
+};
+
+// The kernels which can run on this processor. The fastest one is the last.
+std::vector<ClassificationKernel> get_available_classification_kernels();
+
+// Classifies ClassifiedBlock::SIZE characters.
+void classify_block(ClassificationKernel kernel, const char* data, ClassifiedBlock& block);
+
+// Classifies ClassifiedBlock::SIZE characters with the fastest available kernel.
+void classify_block(const char* data, ClassifiedBlock& block);
+
+// Finds the characters of some classes in a text. The text is classified by blocks, in one
+// pass over each block, and the blocks are only classified up to where the searches go.
+class CharacterClassifier
+{
+public:
+    explicit CharacterClassifier(std::string_view text);
+
+    // Returns the position of the first character in one of the classes, starting at the
+    // given position, or std::string_view::npos.
+    [[nodiscard]] std::size_t find_first_of(std::size_t position, unsigned classes);
+
+    // Returns the position of the first character in none of the classes, starting at the
+    // given position, or std::string_view::npos.
+    [[nodiscard]] std::size_t find_first_not_of(std::size_t position, unsigned classes);
+
+private:
+    const ClassifiedBlock& get_block(std::size_t block_index);
+    [[nodiscard]] std::size_t get_block_count() const;
+    [[nodiscard]] std::uint64_t get_valid_mask(std::size_t block_index,
+                                               std::size_t position) const;
+
+    std::string_view text;
+    // The blocks classified so far, from the start of the text. Most lines fit in two blocks.
+    SmallVector<ClassifiedBlock, 2> blocks;
+};
+
+#endif //INC_8008_ASSEMBLER_CHARACTER_CLASSIFIER_H
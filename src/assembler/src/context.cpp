@@ -4,39 +4,55 @@
 #include "macro_content.h"
 
 #include <cassert>
-#include <sstream>
+#include <algorithm>
 #include <utility>
 
-Context::Context(Options options) : options{std::move(options)} {}
+Context::Context(Options options)
+    : options{std::move(options)}, symbol_index{std::make_shared<ScopedSymbolIndex>()},
+      scope_path{symbol_index->open_scope({})}
+{}
 
 Context::Context(const std::shared_ptr<Context>& other_context)
-    : options{other_context->options}, parent{other_context}
+    : options{other_context->options}, parent{other_context},
+      symbol_table{other_context->symbol_table.get_interner(), SymbolTable::Storage::SPARSE},
+      symbol_index{other_context->symbol_index},
+      scope_path{symbol_index->open_scope(other_context->scope_path)},
+      expanded_macro{other_context->expanded_macro}
 {}
 
 Context::~Context() = default;
 
 void Context::define_symbol(std::string_view symbol_name, int value)
 {
-    symbol_table.define_symbol(symbol_name, value);
+    define_symbol(get_symbol_interner().intern(symbol_name), symbol_name, value);
 }
 
 std::tuple<bool, int> Context::get_symbol_value(std::string_view symbol_name) const
 {
-    const auto [success, value] = symbol_table.get_symbol_value(symbol_name);
-
-    if (success)
+    const auto symbol_id = get_symbol_interner().find(symbol_name);
+    if (symbol_id == SymbolInterner::NO_SYMBOL)
     {
-        return {success, value};
-    }
-    else if (parent)
-    {
-        return parent->get_symbol_value(symbol_name);
+        return {false, 0};
     }
+    return get_symbol_value(symbol_id);
+}
 
-    return {false, 0};
+SymbolInterner& Context::get_symbol_interner() const { return *symbol_table.get_interner(); }
+
+void Context::define_symbol(SymbolTable::SymbolId symbol_id, std::string_view symbol_name,
+                            int value)
+{
+    symbol_table.define_symbol(symbol_id, symbol_name, value);
+    symbol_index->define_symbol(scope_path, symbol_id, value);
+}
+
+std::tuple<bool, int> Context::get_symbol_value(SymbolTable::SymbolId symbol_id) const
+{
+    return symbol_index->get_symbol_value(scope_path, symbol_id);
 }
 
 void Context::list_symbols(std::ostream& output) { symbol_table.list_symbols(output); }
+const SymbolTable& Context::get_symbol_table() const { return symbol_table; }
 
 Options& Context::get_options() { return options; }
 const Options& Context::get_options() const { return options; }
@@ -81,19 +97,11 @@ MacroContent* Context::get_macro_content(std::string_view macro_name) const
 void Context::call_macro(MacroContent* macro_content, const std::vector<std::string>& arguments,
                          FileReader& file_reader, const std::function<void()>& callback)
 {
-    // Create the parameters/arguments association
-    const auto& parameters = macro_content->get_parameters();
-    auto arg_it = std::begin(arguments);
-
-    for (const auto& param : parameters)
-    {
-        macro_param_arg_association[param] = *arg_it;
-        ++arg_it;
-    }
+    expanded_macro = macro_content;
+    macro_arguments = arguments;
 
     // Insert the content of the macro in the input lines
-    auto stream = macro_content->get_line_stream();
-    file_reader.insert_now(std::move(stream), macro_content->get_name(), callback);
+    file_reader.insert_now(macro_content->get_body(), macro_content->get_name(), callback);
 }
 
 void Context::start_macro(const std::string& macro_name, const std::vector<std::string>& arguments)
@@ -117,7 +125,7 @@ void Context::stop_macro()
     }
 }
 
-void Context::record_macro_line(const std::string& line)
+void Context::record_macro_line(std::string_view line)
 {
     assert(currently_recording_macro.get() != nullptr);
     assert(get_parsing_mode() == Context::MACRO_RECORDING);
@@ -125,18 +133,34 @@ void Context::record_macro_line(const std::string& line)
     currently_recording_macro->append_line(line);
 }
 
-void Context::replace_macro_tokens(std::vector<std::string>& tokens)
+const MacroContent::LineTemplate*
+Context::get_macro_line_template(const std::shared_ptr<const SourceBuffer>& source,
+                                 std::size_t line_number) const
+{
+    if (expanded_macro == nullptr)
+    {
+        return nullptr;
+    }
+    return expanded_macro->get_line_template(source, line_number);
+}
+
+void Context::substitute_macro_arguments(const MacroContent::LineTemplate* line_template,
+                                         LineTokenizer::Arguments& arguments) const
 {
-    for (auto& token : tokens)
+    // Only the lines read in the context of the call have their parameters substituted.
+    if (macro_arguments.empty())
     {
-        std::string lowercase{token};
-        std::transform(std::begin(lowercase), std::end(lowercase), std::begin(lowercase),
-                       ::tolower);
-        auto it = macro_param_arg_association.find(lowercase);
+        return;
+    }
 
-        if (it != std::end(macro_param_arg_association))
+    for (std::size_t index = 0; index < arguments.size(); index += 1)
+    {
+        const auto parameter_index = line_template
+                                             ? line_template->parameter_indices[index]
+                                             : expanded_macro->find_parameter(arguments[index]);
+        if (parameter_index != MacroContent::LineTemplate::NO_PARAMETER)
         {
-            token = it->second;
+            arguments[index] = macro_arguments[parameter_index];
         }
     }
 }
@@ -2,7 +2,9 @@
 #define INC_8008_ASSEMBLER_CONTEXT_H
 
 #include "errors.h"
+#include "macro_content.h"
 #include "options.h"
+#include "scoped_symbol_index.h"
 #include "symbol_table.h"
 
 #include <functional>
@@ -10,8 +12,8 @@
 #include <ostream>
 #include <string_view>
 
-class MacroContent;
 class FileReader;
+class SourceBuffer;
 
 struct Context
 {
@@ -25,7 +27,14 @@ struct Context
 
     void define_symbol(std::string_view symbol_name, int value);
     [[nodiscard]] std::tuple<bool, int> get_symbol_value(std::string_view symbol_name) const;
+
+    /// All the contexts of an assembly share the same interner and symbol index, so a symbol
+    /// is found in the context or its parents with a single lookup of its identifier.
+    [[nodiscard]] SymbolInterner& get_symbol_interner() const;
+    void define_symbol(SymbolTable::SymbolId symbol_id, std::string_view symbol_name, int value);
+    [[nodiscard]] std::tuple<bool, int> get_symbol_value(SymbolTable::SymbolId symbol_id) const;
     void list_symbols(std::ostream& output);
+    [[nodiscard]] const SymbolTable& get_symbol_table() const;
 
     enum ParsingMode
     {
@@ -46,23 +55,37 @@ struct Context
     void stop_macro();
 
     /// Records a line for the current macro
-    void record_macro_line(const std::string& line);
+    void record_macro_line(std::string_view line);
 
     [[nodiscard]] bool has_macro(const std::string_view& macro_name) const;
     MacroContent* get_macro_content(std::string_view macro_name) const;
     void call_macro(MacroContent* macro_content, const std::vector<std::string>& arguments,
                     FileReader& file_reader, const std::function<void()>& callback);
-    void replace_macro_tokens(std::vector<std::string>& tokens);
+
+    /// Returns the template of a line if it comes from the body of the macro being expanded.
+    [[nodiscard]] const MacroContent::LineTemplate* get_macro_line_template(
+            const std::shared_ptr<const SourceBuffer>& source, std::size_t line_number) const;
+
+    /// Substitutes the macro call arguments in the arguments of a line. The line template,
+    /// when the line has one, already knows which arguments are parameters.
+    void substitute_macro_arguments(const MacroContent::LineTemplate* line_template,
+                                    LineTokenizer::Arguments& arguments) const;
 
 private:
     const std::shared_ptr<Context> parent;
 
     Options options;
     SymbolTable symbol_table;
+    std::shared_ptr<ScopedSymbolIndex> symbol_index;
+    ScopedSymbolIndex::ScopePath scope_path;
     ParsingMode parsing_mode{ACTIVE};
     std::unique_ptr<MacroContent> currently_recording_macro{};
     std::unordered_map<std::string, std::unique_ptr<MacroContent>> macros;
-    std::unordered_map<std::string, std::string> macro_param_arg_association;
+
+    // The macro being expanded, shared with the contexts opened during the expansion.
+    const MacroContent* expanded_macro{nullptr};
+    // The arguments of the macro call, only in the context of the call.
+    std::vector<std::string> macro_arguments;
 
     void declare_macro(std::unique_ptr<MacroContent> macro_content);
 };
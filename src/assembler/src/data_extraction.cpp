@@ -5,7 +5,8 @@
 #include <algorithm>
 #include <cassert>
 
-size_t string_to_bytes(const Context& context, const std::string& data, std::vector<int>& out_data)
+size_t string_to_bytes(const Context& context, std::string_view data,
+                       std::pmr::vector<int>& out_data)
 {
     // DATA "..." or DATA '...' declare strings of characters
     // The argument has already been extracted (by the LineTokenizer), so it is assured
@@ -65,8 +66,8 @@ size_t string_to_bytes(const Context& context, const std::string& data, std::vec
     return out_data.size() - starting_size;
 }
 
-int decode_data(const Context& context, const std::vector<std::string>& tokens,
-                std::vector<int>& out_data)
+int decode_data(const Context& context, std::span<const std::string_view> tokens,
+                std::pmr::vector<int>& out_data)
 {
     assert(out_data.empty());
 
@@ -81,7 +82,7 @@ int decode_data(const Context& context, const std::vector<std::string>& tokens,
         // 'DATA *NNN' reserve NNN bytes.
         // int number_to_reserve = std::stoi(data_part.substr(1).data());
         const auto first_comment = first_argument.find_first_of(';');
-        auto without_comment = std::string{first_argument.substr(0, first_comment)};
+        auto without_comment = first_argument.substr(0, first_comment);
         int number_to_reserve = evaluate_argument(context, without_comment.substr(1));
         return 0 - number_to_reserve;
     }
@@ -4,6 +4,8 @@
 #include "context.h"
 #include "errors.h"
 
+#include <memory_resource>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -17,8 +19,8 @@ class SymbolTable;
 // Any string starting with an isalpha character denotes a symbol
 //
 // If the return value is negative, it's a reservation of uninitialized memory of the absolute value.
-int decode_data(const Context& context, const std::vector<std::string>& tokens,
-                std::vector<int>& out_data);
+int decode_data(const Context& context, std::span<const std::string_view> tokens,
+                std::pmr::vector<int>& out_data);
 
 class DataTooLong : public ExceptionWithReason
 {
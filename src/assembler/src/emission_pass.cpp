@@ -0,0 +1,131 @@
+#include "emission_pass.h"
+
+#include "byte_writer.h"
+#include "context.h"
+#include "errors.h"
+#include "listing.h"
+#include "listing_pass.h"
+#include "options.h"
+#include "parsed_line_storage.h"
+#include "second_pass.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    // Small sources are built by a single task, on the calling thread.
+    constexpr std::size_t LINES_PER_CHUNK = 4096;
+
+    struct BuildFailure
+    {
+        std::size_t line_index;
+        std::exception_ptr exception;
+    };
+
+    // Builds all the lines and returns the first failure in the order of the lines, if any.
+    // The line count is given for no failure.
+    BuildFailure build_lines(const Options& global_options,
+                             ParsedLineStorage& parsed_line_storage)
+    {
+        const auto line_count = parsed_line_storage.size();
+        const auto chunk_count = (line_count + LINES_PER_CHUNK - 1) / LINES_PER_CHUNK;
+
+        std::vector<BuildFailure> failures(chunk_count, {line_count, nullptr});
+        std::vector<ThreadPool::Task> tasks;
+        tasks.reserve(chunk_count);
+        for (std::size_t chunk = 0; chunk < chunk_count; chunk += 1)
+        {
+            const auto first_line = chunk * LINES_PER_CHUNK;
+            const auto last_line = std::min(first_line + LINES_PER_CHUNK, line_count);
+            tasks.emplace_back([&parsed_line_storage, first_line, last_line,
+                                &failure = failures[chunk]] {
+                for (auto index = first_line; index < last_line; index += 1)
+                {
+                    const auto parsed_line = parsed_line_storage[index];
+                    try
+                    {
+                        parsed_line.instruction.build(parsed_line.context,
+                                                      parsed_line.line_address);
+                    }
+                    catch (...)
+                    {
+                        // The rest of the chunk isn't needed.
+                        failure = {index, std::current_exception()};
+                        return;
+                    }
+                }
+            });
+        }
+
+        const ThreadPool thread_pool{global_options.thread_count};
+        thread_pool.run(tasks);
+
+        const auto first_failure = std::ranges::find_if(
+                failures, [](const auto& failure) { return failure.exception != nullptr; });
+        return first_failure == std::end(failures) ? BuildFailure{line_count, nullptr}
+                                                   : *first_failure;
+    }
+}
+
+void emission_pass(const Options& global_options, ByteWriter& writer,
+                   std::ostream& listing_stream, ParsedLineStorage& parsed_line_storage)
+{
+    if (global_options.verbose || global_options.debug)
+    {
+        Listing listing(listing_stream, global_options);
+        second_pass(global_options, writer, parsed_line_storage);
+        listing_pass(global_options, parsed_line_storage, listing);
+        return;
+    }
+
+    // The listing is kept until all the lines are written.
+    std::ostringstream listing_buffer;
+    Listing listing(listing_buffer, global_options);
+
+    const bool generate_list_file = global_options.generate_list_file;
+    if (generate_list_file)
+    {
+        listing.write_listing_header();
+    }
+
+    const auto build_failure = build_lines(global_options, parsed_line_storage);
+
+    // The bytes are written in order, up to the first line that fails, to be built or written.
+    for (std::size_t line_index = 0; const auto parsed_line : parsed_line_storage)
+    {
+        const auto& input_line = parsed_line.line;
+        const auto line_number = parsed_line.line_number;
+        int line_address = parsed_line.line_address;
+        const auto& instruction = parsed_line.instruction;
+
+        try
+        {
+            if (line_index == build_failure.line_index)
+            {
+                std::rethrow_exception(build_failure.exception);
+            }
+            instruction.write_bytes(parsed_line.context, writer, line_address);
+        }
+        catch (const std::exception& ex)
+        {
+            throw ParsingException(ex, line_number, parsed_line.name_tag, input_line);
+        }
+
+        // The line is listed along with its bytes.
+        if (generate_list_file)
+        {
+            instruction.listing_pass(listing, input_line, line_number, line_address);
+        }
+        line_index += 1;
+    }
+    writer.write_end();
+
+    if (generate_list_file)
+    {
+        listing_stream << listing_buffer.view();
+    }
+}
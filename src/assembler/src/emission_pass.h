@@ -0,0 +1,19 @@
+#ifndef INC_8008_ASSEMBLER_EMISSION_PASS_H
+#define INC_8008_ASSEMBLER_EMISSION_PASS_H
+
+#include <ostream>
+
+class ByteWriter;
+class Options;
+class ParsedLineStorage;
+
+// Writes the bytes and the listing of each line in a single walk over the parsed lines, once
+// the symbols are defined. As with separate passes, nothing is listed if a line fails.
+// The lines are first built in parallel, by chunks, with the thread count of the options.
+// The error reported is still the one of the first failing line.
+// The verbose and debug traces are given pass by pass, so in these modes, the second pass
+// and the listing pass run one after the other, on the calling thread.
+void emission_pass(const Options& global_options, ByteWriter& writer,
+                   std::ostream& listing_stream, ParsedLineStorage& parsed_line_storage);
+
+#endif //INC_8008_ASSEMBLER_EMISSION_PASS_H
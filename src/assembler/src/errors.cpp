@@ -4,16 +4,17 @@
 const char* ExceptionWithReason::what() const noexcept { return reason.c_str(); }
 
 ParsingException::ParsingException(const std::exception& ex, std::size_t line_number,
-                                   const std::string& line)
+                                   std::string_view line)
 {
-    reason = std::string{ex.what()} + " in line " + std::to_string(line_number) + ": " + line;
+    reason = std::string{ex.what()} + " in line " + std::to_string(line_number) + ": " +
+             std::string{line};
 }
 
 ParsingException::ParsingException(const std::exception& ex, std::size_t line_number,
-                                   const std::string_view context_name, const std::string& line)
+                                   std::string_view context_name, std::string_view line)
 {
     reason = std::string{ex.what()} + " in line " + std::string{context_name} +
-             "::" + std::to_string(line_number) + ": " + line;
+             "::" + std::to_string(line_number) + ": " + std::string{line};
 }
 
 InternalError::InternalError(const std::string& line) { reason = "internal error: " + line; }
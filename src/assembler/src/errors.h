@@ -18,9 +18,9 @@ class ParsingException : public ExceptionWithReason
 {
 public:
     explicit ParsingException(const std::exception& ex, std::size_t line_number,
-                              const std::string& line);
+                              std::string_view line);
     explicit ParsingException(const std::exception& ex, std::size_t line_number,
-                              const std::string_view context_name, const std::string& line);
+                              std::string_view context_name, std::string_view line);
 };
 
 class InternalError : public ExceptionWithReason
@@ -0,0 +1,170 @@
+#include "compiled_expression.h"
+
+#include "context.h"
+#include "evaluate.h"
+#include "evaluator.h"
+#include "string_to_int.h"
+
+#include <array>
+#include <cassert>
+#include <iostream>
+
+bool compile_new_expression(std::string_view expression, EvaluationFlags::Flags flags,
+                            CompiledExpression::Program& program);
+
+CompiledExpression::CompiledExpression(const Context& context, std::string_view text,
+                                       std::pmr::memory_resource* memory_resource)
+    : text{text}, byte_selections{memory_resource}, program{memory_resource}
+{
+    // The same wrappers as evaluate_argument(), checked in the same order.
+    std::string_view expression{this->text};
+    while (true)
+    {
+        if (expression.starts_with("\\HB\\"))
+        {
+            byte_selections.push_back(ByteSelection::HIGH);
+            expression = expression.substr(4);
+        }
+        else if (expression.starts_with("H(") && expression.ends_with(')'))
+        {
+            byte_selections.push_back(ByteSelection::HIGH);
+            expression = expression.substr(2, expression.size() - 2 - 1);
+        }
+        else if (expression.starts_with("\\LB\\"))
+        {
+            byte_selections.push_back(ByteSelection::LOW);
+            expression = expression.substr(4);
+        }
+        else if (expression.starts_with("L(") && expression.ends_with(')'))
+        {
+            byte_selections.push_back(ByteSelection::LOW);
+            expression = expression.substr(2, expression.size() - 2 - 1);
+        }
+        else
+        {
+            break;
+        }
+    }
+    expression_start = expression.data() - this->text.data();
+    expression_size = expression.size();
+
+    const auto& options = context.get_options();
+    if (options.legacy_evaluator)
+    {
+        return;
+    }
+
+    compiled = compile_new_expression(
+            expression, EvaluationFlags::get_flags_from_options(options), program);
+    if (compiled)
+    {
+        auto& symbol_interner = context.get_symbol_interner();
+        for (auto& symbol : program.symbols)
+        {
+            symbol.id = symbol_interner.intern(symbol.name);
+        }
+        interner = &symbol_interner;
+    }
+}
+
+int CompiledExpression::evaluate(const Context& context) const
+{
+    if (!compiled)
+    {
+        return evaluate_argument(context, text);
+    }
+
+    const auto& options = context.get_options();
+    if (options.debug)
+    {
+        std::cout << "evaluating " << text.substr(expression_start, expression_size) << "\n";
+    }
+
+    int result = execute(context);
+
+    if (options.debug)
+    {
+        std::cout << "     got final value " << result << "\n";
+    }
+
+    // The innermost wrapper applies first.
+    for (auto it = byte_selections.rbegin(); it != byte_selections.rend(); ++it)
+    {
+        result = (*it == ByteSelection::HIGH) ? ((result >> 8) & 0xFF) : (result & 0xFF);
+    }
+    return result;
+}
+
+int CompiledExpression::execute(const Context& context) const
+{
+    using Operation = Program::Operation;
+
+    // Expressions rarely need a deep stack. The compilation checked that every step has
+    // its operands.
+    std::array<int, 16> inline_stack;
+    std::vector<int> heap_stack;
+    int* stack = inline_stack.data();
+    if (program.max_depth > inline_stack.size())
+    {
+        heap_stack.resize(program.max_depth);
+        stack = heap_stack.data();
+    }
+
+    std::size_t depth = 0;
+    for (const auto& [operation, operand] : program.steps)
+    {
+        switch (operation)
+        {
+            case Operation::PUSH_VALUE:
+                stack[depth++] = operand;
+                break;
+            case Operation::PUSH_SYMBOL:
+                stack[depth++] = get_symbol_value(context, operand);
+                break;
+            case Operation::ADD:
+                depth -= 1;
+                stack[depth - 1] = stack[depth - 1] + stack[depth];
+                break;
+            case Operation::SUBTRACT:
+                depth -= 1;
+                stack[depth - 1] = stack[depth - 1] - stack[depth];
+                break;
+            case Operation::MULTIPLY:
+                depth -= 1;
+                stack[depth - 1] = stack[depth - 1] * stack[depth];
+                break;
+            case Operation::DIVIDE:
+                if (stack[depth - 1] == 0)
+                {
+                    throw IllFormedExpression{};
+                }
+                depth -= 1;
+                stack[depth - 1] = stack[depth - 1] / stack[depth];
+                break;
+            case Operation::NEGATE:
+                stack[depth - 1] = -stack[depth - 1];
+                break;
+            case Operation::SQUARE:
+                stack[depth - 1] = stack[depth - 1] * stack[depth - 1];
+                break;
+            case Operation::POP_TO_ZERO:
+                depth -= operand;
+                stack[depth++] = 0;
+                break;
+        }
+    }
+    return depth == 0 ? 0 : stack[depth - 1];
+}
+
+int CompiledExpression::get_symbol_value(const Context& context, int symbol_index) const
+{
+    const auto& symbol = program.symbols[symbol_index];
+    const auto [success, value] = (&context.get_symbol_interner() == interner)
+                                          ? context.get_symbol_value(symbol.id)
+                                          : context.get_symbol_value(symbol.name);
+    if (success)
+    {
+        return value;
+    }
+    throw CannotFindSymbol{symbol.name};
+}
@@ -0,0 +1,95 @@
+#ifndef INC_8008_ASSEMBLER_COMPILED_EXPRESSION_H
+#define INC_8008_ASSEMBLER_COMPILED_EXPRESSION_H
+
+#include "symbol_interner.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Context;
+
+// An argument compiled once, when its line is parsed, and executed each time its value is
+// needed. The expression becomes a list of steps on a stack of values, in the order the
+// evaluator applies its operations, and its symbols are resolved to their identifiers.
+//
+// Compiling never throws. An argument which can't be compiled, or which is evaluated by
+// the legacy evaluator, is kept as text and evaluated as before, with the same errors.
+//
+// The steps are allocated from the given memory resource, which must outlive the expression.
+class CompiledExpression
+{
+public:
+    struct Program
+    {
+        enum class Operation : std::uint8_t
+        {
+            PUSH_VALUE,
+            PUSH_SYMBOL,
+            ADD,
+            SUBTRACT,
+            MULTIPLY,
+            DIVIDE,
+            NEGATE,
+            SQUARE,
+            // Unknown operations and functions pop their operands and give 0.
+            POP_TO_ZERO,
+        };
+
+        struct Step
+        {
+            Operation operation;
+            // The value to push, the index of the symbol, or the operand count to pop.
+            int operand;
+        };
+
+        struct SymbolReference
+        {
+            std::string name;
+            SymbolInterner::SymbolId id{SymbolInterner::NO_SYMBOL};
+        };
+
+        explicit Program(std::pmr::memory_resource* memory_resource)
+            : steps{memory_resource}, symbols{memory_resource}
+        {
+        }
+
+        std::pmr::vector<Step> steps;
+        std::pmr::vector<SymbolReference> symbols;
+        std::size_t max_depth{0};
+    };
+
+    CompiledExpression(
+            const Context& context, std::string_view text,
+            std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource());
+
+    int evaluate(const Context& context) const;
+
+    [[nodiscard]] const std::string& get_text() const { return text; }
+    [[nodiscard]] bool is_compiled() const { return compiled; }
+
+private:
+    enum class ByteSelection : std::uint8_t
+    {
+        HIGH,
+        LOW,
+    };
+
+    [[nodiscard]] int execute(const Context& context) const;
+    [[nodiscard]] int get_symbol_value(const Context& context, int symbol_index) const;
+
+    std::string text;
+    // The \HB\, H(), \LB\ and L() wrappers, from the outermost, around the expression.
+    std::pmr::vector<ByteSelection> byte_selections;
+    std::size_t expression_start{0};
+    std::size_t expression_size{0};
+
+    bool compiled{false};
+    Program program;
+    // The identifiers of the symbols are only valid for the contexts sharing this interner.
+    const SymbolInterner* interner{nullptr};
+};
+
+#endif //INC_8008_ASSEMBLER_COMPILED_EXPRESSION_H
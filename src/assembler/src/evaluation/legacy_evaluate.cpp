@@ -5,12 +5,63 @@
 #include "opcodes/opcodes.h"
 #include "options.h"
 #include "string_to_int.h"
-#include "utils.h"
 
+#include <cctype>
 #include <iostream>
-#include <regex>
+#include <tuple>
 
-std::regex not_an_operator{R"(^\s*([^\+\*-/#\s]+)\s*)"};
+namespace
+{
+    // The operands are made of anything but the blanks, the operators, and the ',' and '.'
+    // which are in the '*'-'/' range of the as8 pattern [^+*-/#\s].
+    bool is_operand_character(char c)
+    {
+        switch (c)
+        {
+            case '+':
+            case '*':
+            case ',':
+            case '-':
+            case '.':
+            case '/':
+            case '#':
+                return false;
+            default:
+                return !std::isspace(static_cast<unsigned char>(c));
+        }
+    }
+
+    bool is_blank(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+
+    // Scans the blanks, an operand, and the blanks after it, as the as8 pattern
+    // ^\s*([^+*-/#\s]+)\s* does. Returns the operand and the scanned size, or an empty
+    // operand when the text doesn't start with one.
+    std::tuple<std::string_view, std::size_t> scan_operand(std::string_view text)
+    {
+        std::size_t index = 0;
+        while (index < text.size() && is_blank(text[index]))
+        {
+            index += 1;
+        }
+
+        const auto operand_start = index;
+        while (index < text.size() && is_operand_character(text[index]))
+        {
+            index += 1;
+        }
+        const auto operand = text.substr(operand_start, index - operand_start);
+        if (operand.empty())
+        {
+            return {operand, 0};
+        }
+
+        while (index < text.size() && is_blank(text[index]))
+        {
+            index += 1;
+        }
+        return {operand, index};
+    }
+}
 
 int symbol_to_int(const Context& context, const std::basic_string<char>& to_parse)
 {
@@ -118,17 +169,15 @@ int legacy_evaluator(const Context& context, std::string_view arg)
         else
         {
             // Parse Operand
-            std::string value_to_parse(arg_to_parse);
-            std::smatch data_match;
-            bool found = std::regex_search(value_to_parse, data_match, not_an_operator);
+            const auto [operand, scanned_size] = scan_operand(arg_to_parse);
 
-            if (!found)
+            if (operand.empty())
             {
                 throw ExpectedValue(arg_to_parse);
             }
 
-            acc.add_operand(trim_string(data_match.str()));
-            arg_to_parse = arg_to_parse.substr(data_match.length());
+            acc.add_operand(operand);
+            arg_to_parse = arg_to_parse.substr(scanned_size);
         }
 
         // Parse Operator
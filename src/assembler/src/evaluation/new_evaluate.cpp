@@ -1,43 +1,286 @@
 #include "new_evaluate.h"
+#include "compiled_expression.h"
 #include "context.h"
 #include "evaluate.h"
 
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
 namespace SE = SimpleEvaluator;
 
+// The configuration is built for each evaluation. It only refers to the context, and the
+// functions are immutable, so evaluations can run in parallel.
 struct Configuration
 {
-    Context* context{};
+    const Context& context;
 
-    int symbol_to_value(const std::string& symbol_name) const
+    int symbol_to_value(std::string_view symbol_name) const
     {
-        const auto [success, value] = context->get_symbol_value(symbol_name);
+        const auto [success, value] = context.get_symbol_value(symbol_name);
         if (success)
         {
             return value;
         }
-        throw CannotFindSymbol{symbol_name};
+        throw CannotFindSymbol{std::string{symbol_name}};
     }
 
-    std::unordered_map<std::string, SE::function_type> functions{
+    static constexpr std::pair<std::string_view, SE::function_type> functions[]{
             {"square", [](const int* data) { return data[0] * data[0]; }},
     };
 
-    SE::function_type function_to_value(const std::string& function_name) const
+    SE::function_type function_to_value(std::string_view function_name) const
     {
-        auto it = functions.find(function_name);
+        const auto it = std::find_if(std::begin(functions), std::end(functions),
+                                     [&](const auto& function)
+                                     { return function.first == function_name; });
         return (it == std::end(functions)) ? [](const int*) { return 0; } : it->second;
     }
 };
 
 int new_evaluator(const Context& context, std::string_view arg)
 {
-    static Configuration configuration;
+    const Configuration configuration{context};
+    return SE::evaluate(configuration,
+                        EvaluationFlags::get_flags_from_options(context.get_options()), arg);
+}
+
+namespace
+{
+    using Program = CompiledExpression::Program;
+
+    // An operation waiting on the stack of the compiler, as in SimpleEvaluator::evaluate.
+    struct PendingOperation
+    {
+        int precedence;
+        int arity; // -1 for an opening parenthesis.
+        Program::Operation operation;
+    };
+
+    constexpr PendingOperation opening_parenthesis{0, -1, Program::Operation::POP_TO_ZERO};
+
+    PendingOperation get_binary_operation(char token)
+    {
+        switch (token)
+        {
+            case '+':
+                return {1, 2, Program::Operation::ADD};
+            case '-':
+                return {1, 2, Program::Operation::SUBTRACT};
+            case '*':
+                return {2, 2, Program::Operation::MULTIPLY};
+            case '/':
+                return {2, 2, Program::Operation::DIVIDE};
+            default:
+                return {99, 2, Program::Operation::POP_TO_ZERO};
+        }
+    }
+
+    // Only called for the tokens SE::in_unary_in_context accepts.
+    std::optional<PendingOperation> get_unary_operation(char token)
+    {
+        switch (token)
+        {
+            case '+':
+                return std::nullopt; // The identity.
+            case '-':
+                return PendingOperation{99, 1, Program::Operation::NEGATE};
+            default:
+                return PendingOperation{99, 2, Program::Operation::POP_TO_ZERO};
+        }
+    }
+
+    class Compiler
+    {
+    public:
+        explicit Compiler(Program& program) : program{program} {}
+
+        void push_value(int value) { push_step({Program::Operation::PUSH_VALUE, value}); }
 
-    // The glue is not pretty...
-    configuration.context = const_cast<Context*>(&context);
-    auto value = SE::evaluate(configuration,
-                              EvaluationFlags::get_flags_from_options(context.get_options()), arg);
+        void push_symbol(std::string symbol_name)
+        {
+            program.symbols.push_back({std::move(symbol_name)});
+            push_step({Program::Operation::PUSH_SYMBOL,
+                       static_cast<int>(program.symbols.size() - 1)});
+        }
+
+        void push_operation(std::optional<PendingOperation> operation)
+        {
+            operations.push_back(operation);
+        }
+
+        [[nodiscard]] bool has_operations() const { return !operations.empty(); }
+
+        [[nodiscard]] const std::optional<PendingOperation>& top_operation() const
+        {
+            return operations.back();
+        }
 
-    configuration.context = nullptr;
-    return value;
+        void pop_operation() { operations.pop_back(); }
+
+        // False where the evaluator would throw, either because a value is missing, or because
+        // it applies an opening parenthesis.
+        [[nodiscard]] bool pop_and_apply_operation()
+        {
+            const auto operation = operations.back();
+            operations.pop_back();
+
+            if (!operation.has_value())
+            {
+                // The unary plus leaves its operand as is.
+                return depth >= 1;
+            }
+
+            const auto [precedence, arity, code] = *operation;
+            if (arity < 0 || depth < static_cast<std::size_t>(arity))
+            {
+                return false;
+            }
+            depth -= arity;
+            push_step({code, code == Program::Operation::POP_TO_ZERO ? arity : 0});
+            return true;
+        }
+
+    private:
+        void push_step(Program::Step step)
+        {
+            // Each step pushes one value, after the operation popped its operands.
+            program.steps.push_back(step);
+            depth += 1;
+            program.max_depth = std::max(program.max_depth, depth);
+        }
+
+        Program& program;
+        std::vector<std::optional<PendingOperation>> operations;
+        std::size_t depth{0};
+    };
+
+    bool compile_tokens(std::string_view tokens, EvaluationFlags::Flags flags, Program& program)
+    {
+        Compiler compiler{program};
+
+        std::size_t index = 0;
+        char previous_token = 0;
+        bool has_previous_token = false;
+
+        while (index < tokens.length())
+        {
+            auto token = tokens[index];
+
+            switch (token)
+            {
+                case ' ':
+                    index += 1;
+                    continue;
+                case '(':
+                    compiler.push_operation(opening_parenthesis);
+                    break;
+                case ')':
+                    while (compiler.has_operations() &&
+                           (!compiler.top_operation().has_value() ||
+                            compiler.top_operation()->arity != -1))
+                    {
+                        if (!compiler.pop_and_apply_operation())
+                        {
+                            return false;
+                        }
+                    }
+                    if (!compiler.has_operations())
+                    {
+                        return false;
+                    }
+                    compiler.pop_operation();
+                    break;
+                default:
+                    if (std::isdigit(token) || token == '\'')
+                    {
+                        if (token == '\'' &&
+                            !((index + 2) < tokens.length() && tokens[index + 2] == '\''))
+                        {
+                            // The evaluator reads an empty number there.
+                            return false;
+                        }
+                        auto [value, new_index] = SE::string_to_decimal(flags, tokens, index);
+                        compiler.push_value(value);
+                        index = new_index - 1;
+                    }
+                    else if (std::isalpha(token))
+                    {
+                        auto [symbol, i] = SE::string_to_symbol(tokens, index);
+                        if (i < tokens.size() && tokens[i] == '(')
+                        {
+                            compiler.push_operation(PendingOperation{
+                                    99, 1,
+                                    symbol == "square" ? Program::Operation::SQUARE
+                                                       : Program::Operation::POP_TO_ZERO});
+                        }
+                        else
+                        {
+                            compiler.push_symbol(std::string{symbol});
+                        }
+                        index = i - 1;
+                    }
+                    else
+                    {
+                        if ((token == '-' || token == '+') && index != 0 && !has_previous_token)
+                        {
+                            // The evaluator would read its previous token before setting it.
+                            return false;
+                        }
+                        if (SE::in_unary_in_context(token, previous_token, index))
+                        {
+                            compiler.push_operation(get_unary_operation(token));
+                            if (SE::is_suffix_operator(token) &&
+                                !compiler.pop_and_apply_operation())
+                            {
+                                return false;
+                            }
+                        }
+                        else
+                        {
+                            const auto operation = get_binary_operation(token);
+                            while (compiler.has_operations() &&
+                                   (compiler.top_operation().has_value()
+                                            ? compiler.top_operation()->precedence
+                                            : 99) >= operation.precedence)
+                            {
+                                if (!compiler.pop_and_apply_operation())
+                                {
+                                    return false;
+                                }
+                            }
+                            compiler.push_operation(operation);
+                        }
+                    }
+            }
+
+            previous_token = token;
+            has_previous_token = true;
+            index += 1;
+        }
+
+        while (compiler.has_operations())
+        {
+            if (!compiler.pop_and_apply_operation())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool compile_new_expression(std::string_view expression, EvaluationFlags::Flags flags,
+                            CompiledExpression::Program& program)
+{
+    try
+    {
+        return compile_tokens(expression, flags, program);
+    }
+    catch (const ExceptionWithReason&)
+    {
+        // Invalid numbers are reported when the expression is evaluated, as before.
+        return false;
+    }
 }
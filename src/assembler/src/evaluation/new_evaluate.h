@@ -1,13 +1,13 @@
 #include "evaluate.h"
+#include "small_vector.h"
 #include "string_to_int.h"
 
+#include <array>
 #include <cctype>
 #include <concepts>
 #include <functional>
-#include <stack>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 
 class Context;
 
@@ -17,10 +17,8 @@ namespace SimpleEvaluator
     {
     };
 
-    namespace
-    {
-        using function_type = std::function<int(const int*)>;
-    }
+    // Plain functions, so that the operations can be copied and stacked without allocation.
+    using function_type = int (*)(const int*);
 
     struct Operation
     {
@@ -30,79 +28,66 @@ namespace SimpleEvaluator
         function_type function;
     };
 
+    constexpr int MAX_ARITY = 2;
+
+    // Typical expressions fit in the inline stacks, deeper ones spill to the heap.
+    using ValueStack = SmallVector<int, 16>;
+    using OperationStack = SmallVector<Operation, 16>;
+
     template<typename T>
     concept is_a_configuration = requires(T v) {
                                      {
-                                         v.symbol_to_value("")
+                                         v.symbol_to_value(std::string_view{})
                                          } -> std::convertible_to<int>;
                                      {
-                                         v.function_to_value("")
-                                         } -> std::convertible_to<std::function<int(const int*)>>;
+                                         v.function_to_value(std::string_view{})
+                                         } -> std::convertible_to<function_type>;
                                  };
 
-    std::unordered_map<char, Operation>& get_intrinsic_binaries()
-    {
-        static std::unordered_map<char, Operation> intrinsic_binaries = {
-                // Note: the args are presented in reverse order.
-                {'+', Operation{1, 2, [](const int* args) { return args[1] + args[0]; }}},
-                {'-', Operation{1, 2, [](const int* args) { return args[1] - args[0]; }}},
-                {'*', Operation{2, 2, [](const int* args) { return args[1] * args[0]; }}},
-                {'/', Operation{2, 2, [](const int* args) {
-                    if (args[0] == 0) { throw IllFormedExpression{}; }
-                    return args[1] / args[0];
-                }}},
-        };
-
-        return intrinsic_binaries;
-    }
-
-    const Operation& get_intrinsic_binary(char token)
+    // Note: the args are presented in reverse order.
+    constexpr Operation get_intrinsic_binary(char token)
     {
-        const auto& intrinsic_binaries = get_intrinsic_binaries();
-        auto operation_it = intrinsic_binaries.find(token);
-
-        if (operation_it != std::end(intrinsic_binaries))
+        switch (token)
         {
-            return operation_it->second;
+            case '+':
+                return {1, 2, [](const int* args) { return args[1] + args[0]; }};
+            case '-':
+                return {1, 2, [](const int* args) { return args[1] - args[0]; }};
+            case '*':
+                return {2, 2, [](const int* args) { return args[1] * args[0]; }};
+            case '/':
+                return {2, 2, [](const int* args) {
+                            if (args[0] == 0) { throw IllFormedExpression{}; }
+                            return args[1] / args[0];
+                        }};
+            default:
+                return {99, 2, [](const int*) { return 0; }};
         }
-        static Operation missing_operation{99, 2, [](const int* args) { return 0; }};
-        return missing_operation;
     }
 
-    int precedence(char token) { return get_intrinsic_binary(token).precedence; }
-
-    std::unordered_map<char, Operation>& get_intrinsic_unaries()
-    {
-        static std::unordered_map<char, Operation> intrinsic_binaries = {
-                {'+', Operation{99, 1, [](const int* args) { return args[0]; }}},
-                {'-', Operation{99, 1, [](const int* args) { return -args[0]; }}},
-        };
-
-        return intrinsic_binaries;
-    }
+    constexpr int precedence(char token) { return get_intrinsic_binary(token).precedence; }
 
-    Operation get_intrinsic_unary(char token)
+    constexpr Operation get_intrinsic_unary(char token)
     {
-        const auto& intrinsic_unaries = get_intrinsic_unaries();
-        auto operation_it = intrinsic_unaries.find(token);
-
-        if (operation_it != std::end(intrinsic_unaries))
+        switch (token)
         {
-            return operation_it->second;
+            case '+':
+                return {99, 1, [](const int* args) { return args[0]; }};
+            case '-':
+                return {99, 1, [](const int* args) { return -args[0]; }};
+            default:
+                return {99, 2, [](const int*) { return 0; }};
         }
-        static Operation missing_operation{99, 2, [](const int* args) { return 0; }};
-        return missing_operation;
     }
 
     template<typename C>
         requires is_a_configuration<C>
-    void pop_and_apply_op(std::stack<int>& values, std::stack<Operation>& operations,
-                          const C& configuration)
+    void pop_and_apply_op(ValueStack& values, OperationStack& operations, const C& configuration)
     {
-        const auto op = operations.top();
+        const auto op = operations.back();
         const auto arity = op.arity;
 
-        std::vector<int> args;
+        std::array<int, MAX_ARITY> args{};
 
         for (auto i = 0; i < arity; i += 1)
         {
@@ -110,13 +95,17 @@ namespace SimpleEvaluator
             {
                 throw ValueWasExpected{};
             }
-            args.push_back(values.top());
-            values.pop();
+            args[i] = values.back();
+            values.pop_back();
         }
 
-        auto value = op.function(args.data());
-        values.push(value);
-        operations.pop();
+        if (op.function == nullptr)
+        {
+            // An opening parenthesis was left without its closing one.
+            throw std::bad_function_call{};
+        }
+        values.push_back(op.function(args.data()));
+        operations.pop_back();
     }
 
     bool is_valid_digit(char c)
@@ -130,7 +119,7 @@ namespace SimpleEvaluator
         // A bit convoluted...
         if (tokens[index] == '\'' && (index + 2) < tokens.length() && tokens[index + 2] == '\'')
         {
-            const auto value = string_to_int(std::string{tokens.substr(index, 3)}, flags);
+            const auto value = string_to_int(tokens.substr(index, 3), flags);
             return {value, index + 3};
         }
 
@@ -168,45 +157,27 @@ namespace SimpleEvaluator
             }
         }
 
-        int value = string_to_int(std::string{tokens.substr(start_index, size)}, flags);
+        int value = string_to_int(tokens.substr(start_index, size), flags);
 
         return {value, index};
     }
 
-    std::tuple<std::string, std::size_t> string_to_symbol(std::string_view tokens,
-                                                          std::size_t index)
+    std::tuple<std::string_view, std::size_t> string_to_symbol(std::string_view tokens,
+                                                               std::size_t index)
     {
         const std::size_t start = index;
         const auto start_it = std::begin(tokens) + index;
         const auto first_not_alpha = std::find_if_not(start_it, std::end(tokens),
                                                       [](auto c) { return std::isalpha(c) || c == '_'; });
         const auto count = std::distance(start_it, first_not_alpha);
-        std::string value{tokens.substr(start, count)};
-        return {value, start + count};
+        return {tokens.substr(start, count), start + count};
     }
 
     bool is_suffix_operator(char token) { return token == '!'; }
 
-    std::string get_infix_operators_as_string()
-    {
-        const auto& intrinsic_binaries = get_intrinsic_binaries();
-
-        std::string tokens;
-        tokens.reserve(intrinsic_binaries.size());
-
-        for (const auto& pair : intrinsic_binaries)
-        {
-            tokens.push_back(pair.first);
-        }
-
-        return tokens;
-    }
-
-    bool is_infix_operator(char token)
+    constexpr bool is_infix_operator(char token)
     {
-        static auto all_infix_tokens = get_infix_operators_as_string();
-        return std::find(std::begin(all_infix_tokens), std::end(all_infix_tokens), token) !=
-               std::end(all_infix_tokens);
+        return token == '+' || token == '-' || token == '*' || token == '/';
     }
 
     bool in_unary_in_context(char token, char previous_token, std::size_t index)
@@ -234,8 +205,8 @@ namespace SimpleEvaluator
         requires is_a_configuration<C>
     int evaluate(const C& configuration, EvaluationFlags::Flags flags, std::string_view tokens)
     {
-        std::stack<int> values;
-        std::stack<Operation> operations;
+        ValueStack values;
+        OperationStack operations;
 
         std::size_t index = 0;
         char previous_token;
@@ -250,10 +221,10 @@ namespace SimpleEvaluator
                     index += 1;
                     continue;
                 case '(':
-                    operations.push({0, -1, function_type{}});
+                    operations.push_back({0, -1, nullptr});
                     break;
                 case ')':
-                    while (!operations.empty() && operations.top().arity != -1)
+                    while (!operations.empty() && operations.back().arity != -1)
                     {
                         pop_and_apply_op(values, operations, configuration);
                     }
@@ -261,13 +232,13 @@ namespace SimpleEvaluator
                     {
                         throw ValueWasExpected{};
                     }
-                    operations.pop();
+                    operations.pop_back();
                     break;
                 default:
                     if (std::isdigit(token) || token == '\'')
                     {
                         auto [value, new_index] = string_to_decimal(flags, tokens, index);
-                        values.push(value);
+                        values.push_back(value);
                         index = new_index - 1;
                     }
                     else if (std::isalpha(token))
@@ -278,12 +249,12 @@ namespace SimpleEvaluator
                             // This is a function.
                             // A function is  like a suffix operator acting on the evaluation
                             // of the following expression between parenthesis.
-                            operations.push({99, 1, configuration.function_to_value(symbol)});
+                            operations.push_back({99, 1, configuration.function_to_value(symbol)});
                         }
                         else
                         {
                             auto value = configuration.symbol_to_value(symbol);
-                            values.push(value);
+                            values.push_back(value);
                         }
                         index = i - 1;
                     }
@@ -291,7 +262,7 @@ namespace SimpleEvaluator
                     {
                         if (in_unary_in_context(token, previous_token, index))
                         {
-                            operations.push(get_intrinsic_unary(token));
+                            operations.push_back(get_intrinsic_unary(token));
                             if (is_suffix_operator(token))
                             {
                                 pop_and_apply_op(values, operations, configuration);
@@ -301,11 +272,11 @@ namespace SimpleEvaluator
                         {
                             auto current_precedence = precedence(token);
                             while (!operations.empty() &&
-                                   (operations.top().precedence) >= current_precedence)
+                                   (operations.back().precedence) >= current_precedence)
                             {
                                 pop_and_apply_op(values, operations, configuration);
                             }
-                            operations.push(get_intrinsic_binary(token));
+                            operations.push_back(get_intrinsic_binary(token));
                         }
                     }
             }
@@ -318,6 +289,6 @@ namespace SimpleEvaluator
         {
             pop_and_apply_op(values, operations, configuration);
         }
-        return values.empty() ? 0 : values.top();
+        return values.empty() ? 0 : values.back();
     }
 }
@@ -2,72 +2,139 @@
 #include "evaluate.h"
 #include "legacy_evaluate.h"
 #include "options.h"
-#include <iostream>
+
+#include <cctype>
+#include <charconv>
+#include <limits>
+#include <system_error>
+#include <tuple>
 
 EvaluationFlags::Flags EvaluationFlags::get_flags_from_options(const Options& options)
 {
     return options.input_num_as_octal ? ThreeDigitsAsOctal : None;
 }
 
-int parse_number_value(const std::string& to_parse, int base, std::string_view type_name,
-                       bool has_suffix = false)
+namespace
 {
-    std::size_t pos;
-    int val;
-    try
-    {
-        val = std::stoi(to_parse, &pos, base);
-    }
-    catch (const std::invalid_argument& e)
-    {
-        throw InvalidNumber(to_parse, type_name, "invalid");
-    }
-    catch (const std::out_of_range& e)
-    {
-        throw InvalidNumber(to_parse, type_name, "out of range");
-    }
-    const auto expected_pos = has_suffix ? to_parse.size() - 1 : to_parse.size();
-    if (pos != expected_pos)
+    struct ParsedNumber
     {
-        throw InvalidNumber(to_parse, type_name, "invalid");
-    }
-    return val;
-}
+        std::errc error;
+        int value;
+        // The number read and its type, for the error message.
+        std::string_view number;
+        std::string_view type_name;
+    };
 
-int string_to_int(const std::string& to_parse, EvaluationFlags::Flags flags)
-{
-    int val;
-    const auto last_char_in_parsing = tolower(to_parse.back());
-    if (last_char_in_parsing == 'o')
-    {
-        val = parse_number_value(to_parse, 8, "octal", true);
-    }
-    else if (last_char_in_parsing == 'h')
-    {
-        val = parse_number_value(to_parse, 16, "hex", true);
-    }
-    else if (to_parse.starts_with("0x") || to_parse.starts_with("0X"))
-    {
-        val = parse_number_value(to_parse.substr(2), 16, "hex");
-    }
-    else if (last_char_in_parsing == 'b')
+    bool is_hexadecimal_digit(char c) { return std::isxdigit(static_cast<unsigned char>(c)); }
+
+    // Reads the number as std::stoi would, with the leading blanks, sign and "0x" prefix
+    // strtol accepts, but reports the errors as codes. Returns the error, the value and the
+    // count of characters read.
+    std::tuple<std::errc, int, std::size_t> read_number(std::string_view to_parse, int base)
     {
-        val = parse_number_value(to_parse, 2, "binary", true);
+        const char* const begin = to_parse.data();
+        const char* const end = begin + to_parse.size();
+        const char* current = begin;
+
+        while (current != end && std::isspace(static_cast<unsigned char>(*current)))
+        {
+            current += 1;
+        }
+
+        bool is_negative = false;
+        if (current != end && (*current == '+' || *current == '-'))
+        {
+            is_negative = (*current == '-');
+            current += 1;
+        }
+
+        if (base == 16 && (end - current) > 2 && current[0] == '0' &&
+            (current[1] == 'x' || current[1] == 'X') && is_hexadecimal_digit(current[2]))
+        {
+            current += 2;
+        }
+
+        // Unsigned, so that a second sign isn't accepted.
+        unsigned long long magnitude{0};
+        const auto [digits_end, error] = std::from_chars(current, end, magnitude, base);
+        if (error != std::errc{})
+        {
+            return {error, 0, 0};
+        }
+
+        constexpr auto max_magnitude =
+                static_cast<unsigned long long>(std::numeric_limits<int>::max());
+        if (magnitude > max_magnitude + (is_negative ? 1 : 0))
+        {
+            return {std::errc::result_out_of_range, 0, 0};
+        }
+
+        const auto value = static_cast<long long>(magnitude);
+        return {std::errc{}, static_cast<int>(is_negative ? -value : value),
+                static_cast<std::size_t>(digits_end - begin)};
     }
-    else if (last_char_in_parsing == '\'' && to_parse.front() == '\'' && to_parse.size() == 3)
+
+    ParsedNumber parse_number_value(std::string_view to_parse, int base,
+                                    std::string_view type_name, bool has_suffix = false)
     {
-        val = static_cast<unsigned char>(to_parse[1]);
+        const auto [error, value, read_size] = read_number(to_parse, base);
+        if (error != std::errc{})
+        {
+            return {error, 0, to_parse, type_name};
+        }
+
+        const auto expected_size = has_suffix ? to_parse.size() - 1 : to_parse.size();
+        if (read_size != expected_size)
+        {
+            return {std::errc::invalid_argument, 0, to_parse, type_name};
+        }
+        return {std::errc{}, value, to_parse, type_name};
     }
-    else
+
+    ParsedNumber parse_int(std::string_view to_parse, EvaluationFlags::Flags flags)
     {
-        if ((to_parse.size() == 3) && (flags == EvaluationFlags::ThreeDigitsAsOctal))
+        if (to_parse.empty())
+        {
+            return {std::errc::invalid_argument, 0, to_parse, "decimal"};
+        }
+
+        const auto last_char_in_parsing = std::tolower(static_cast<unsigned char>(to_parse.back()));
+        if (last_char_in_parsing == 'o')
         {
-            val = parse_number_value(to_parse, 8, "octal");
+            return parse_number_value(to_parse, 8, "octal", true);
         }
-        else
+        if (last_char_in_parsing == 'h')
         {
-            val = parse_number_value(to_parse, 10, "decimal");
+            return parse_number_value(to_parse, 16, "hex", true);
         }
+        if (to_parse.starts_with("0x") || to_parse.starts_with("0X"))
+        {
+            return parse_number_value(to_parse.substr(2), 16, "hex");
+        }
+        if (last_char_in_parsing == 'b')
+        {
+            return parse_number_value(to_parse, 2, "binary", true);
+        }
+        if (last_char_in_parsing == '\'' && to_parse.front() == '\'' && to_parse.size() == 3)
+        {
+            return {std::errc{}, static_cast<unsigned char>(to_parse[1]), to_parse, "character"};
+        }
+        if ((to_parse.size() == 3) && (flags == EvaluationFlags::ThreeDigitsAsOctal))
+        {
+            return parse_number_value(to_parse, 8, "octal");
+        }
+        return parse_number_value(to_parse, 10, "decimal");
+    }
+}
+
+int string_to_int(std::string_view to_parse, EvaluationFlags::Flags flags)
+{
+    const auto [error, value, number, type_name] = parse_int(to_parse, flags);
+    if (error == std::errc{})
+    {
+        return value;
     }
-    return val;
+    // Only a failure builds an exception.
+    throw InvalidNumber(number, type_name,
+                        error == std::errc::result_out_of_range ? "out of range" : "invalid");
 }
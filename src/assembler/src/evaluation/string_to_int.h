@@ -1,7 +1,7 @@
 #ifndef INC_8008_ASSEMBLER_STRING_TO_INT_H
 #define INC_8008_ASSEMBLER_STRING_TO_INT_H
 
-#include <string>
+#include <string_view>
 
 class Options;
 
@@ -16,6 +16,6 @@ namespace EvaluationFlags
     Flags get_flags_from_options(const Options& options);
 }
 
-int string_to_int(const std::string& to_parse, EvaluationFlags::Flags flags);
+int string_to_int(std::string_view to_parse, EvaluationFlags::Flags flags);
 
 #endif //INC_8008_ASSEMBLER_STRING_TO_INT_H
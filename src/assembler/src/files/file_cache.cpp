@@ -0,0 +1,98 @@
+#include "file_cache.h"
+
+#include <algorithm>
+
+FileCache::FileCache(std::size_t capacity, Storage storage)
+    : capacity{std::max<std::size_t>(capacity, 1)}, storage{storage}
+{
+}
+
+std::shared_ptr<const SourceBuffer> FileCache::get(const std::string& filename)
+{
+    std::error_code error;
+    const auto canonical_path = std::filesystem::canonical(filename, error);
+    if (error || !std::filesystem::is_regular_file(canonical_path, error))
+    {
+        // Missing files will fail to open, and special files can't be cached.
+        return load(filename);
+    }
+
+    const auto modification_time = std::filesystem::last_write_time(canonical_path, error);
+    const auto size = error ? 0 : std::filesystem::file_size(canonical_path, error);
+    if (error)
+    {
+        return load(filename);
+    }
+
+    const auto key = canonical_path.string();
+    {
+        std::lock_guard lock{mutex};
+        auto it = entries.find(key);
+        if (it != std::end(entries) && it->second.modification_time == modification_time &&
+            it->second.size == size)
+        {
+            statistics.hits += 1;
+            recently_used.splice(std::begin(recently_used), recently_used,
+                                 it->second.use_position);
+            return it->second.source;
+        }
+    }
+
+    // The file is loaded outside the lock. If two threads load the same file at the
+    // same time, both loads are valid, and the last one is kept.
+    auto source = load(key);
+    if (source)
+    {
+        std::lock_guard lock{mutex};
+        statistics.misses += 1;
+        if (auto it = entries.find(key); it != std::end(entries))
+        {
+            recently_used.erase(it->second.use_position);
+            entries.erase(it);
+        }
+        recently_used.push_front(key);
+        entries.emplace(key, Entry{modification_time, size, source, std::begin(recently_used)});
+
+        while (entries.size() > capacity)
+        {
+            entries.erase(recently_used.back());
+            recently_used.pop_back();
+            statistics.evictions += 1;
+        }
+    }
+    return source;
+}
+
+FileCache::Statistics FileCache::get_statistics() const
+{
+    std::lock_guard lock{mutex};
+    return statistics;
+}
+
+void FileCache::clear()
+{
+    std::lock_guard lock{mutex};
+    entries.clear();
+    recently_used.clear();
+    statistics = {};
+}
+
+void FileCache::set_storage(Storage storage)
+{
+    std::lock_guard lock{mutex};
+    this->storage = storage;
+    entries.clear();
+    recently_used.clear();
+}
+
+std::shared_ptr<const SourceBuffer> FileCache::load(const std::string& filename) const
+{
+    return storage == Storage::COPIED ? SourceBuffer::copy_file(filename)
+                                      : SourceBuffer::from_file(filename);
+}
+
+FileCache& FileCache::global()
+{
+    static FileCache cache;
+    return cache;
+}
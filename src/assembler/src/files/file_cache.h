@@ -0,0 +1,77 @@
+#ifndef INC_8008_ASSEMBLER_FILE_CACHE_H
+#define INC_8008_ASSEMBLER_FILE_CACHE_H
+
+#include "source_buffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Keeps the content of the read files, so that a file included many times, or by
+// many programs, is only loaded once.
+// Files are identified by their canonical path. A file whose modification time or size
+// changed since it was loaded is loaded again.
+// The cache keeps a bounded number of files, and forgets the least recently used ones first,
+// so that a long running process doesn't keep every file it ever read.
+//
+// The files are mapped by default. A mapped file which is truncated or rewritten in place
+// while it is cached faults when read, so a long running process should copy them instead.
+class FileCache
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+    enum class Storage
+    {
+        MAPPED,
+        COPIED,
+    };
+
+    struct Statistics
+    {
+        std::size_t hits{0};
+        std::size_t misses{0};
+        std::size_t evictions{0};
+    };
+
+    explicit FileCache(std::size_t capacity = DEFAULT_CAPACITY, Storage storage = Storage::MAPPED);
+
+    // Returns the content of the file, or nullptr if the file can't be opened.
+    std::shared_ptr<const SourceBuffer> get(const std::string& filename);
+
+    [[nodiscard]] Statistics get_statistics() const;
+    void clear();
+
+    // Changing the storage forgets the loaded files, so that they are all stored the same way.
+    void set_storage(Storage storage);
+
+    // The cache shared by all the assemblies of the process.
+    static FileCache& global();
+
+private:
+    struct Entry
+    {
+        std::filesystem::file_time_type modification_time;
+        std::uintmax_t size;
+        std::shared_ptr<const SourceBuffer> source;
+        std::list<std::string>::iterator use_position;
+    };
+
+    [[nodiscard]] std::shared_ptr<const SourceBuffer> load(const std::string& filename) const;
+
+    std::size_t capacity;
+    std::atomic<Storage> storage;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    // The keys of the entries, the most recently used first.
+    std::list<std::string> recently_used;
+    Statistics statistics;
+};
+
+#endif //INC_8008_ASSEMBLER_FILE_CACHE_H
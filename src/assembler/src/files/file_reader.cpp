@@ -4,18 +4,20 @@
 #include <istream>
 #include <utility>
 
-FileReader::ReaderContext::ReaderContext(std::unique_ptr<std::istream>&& stream,
+FileReader::ReaderContext::ReaderContext(std::shared_ptr<const SourceBuffer>&& source,
                                          std::string_view name_tag, std::function<void()> callback)
-    : input_stream{std::move(stream)},
+    : source{std::move(source)}, splitter{this->source->get_content()},
       current_line_count{1}, name_tag{name_tag}, callback{std::move(callback)}
 {
-    line_iterator = std::istream_iterator<line>{*input_stream};
+    has_line = read_next_line();
 }
 
-void FileReader::append(std::unique_ptr<std::istream> stream, std::string_view name_tag,
+bool FileReader::ReaderContext::read_next_line() { return splitter.next_line(line); }
+
+void FileReader::append(std::shared_ptr<const SourceBuffer> source, std::string_view name_tag,
                         const std::function<void()>& callback)
 {
-    contexts.emplace_back(std::move(stream), name_tag, callback);
+    contexts.emplace_back(std::move(source), name_tag, callback);
 
     if (exhausted)
     {
@@ -25,25 +27,24 @@ void FileReader::append(std::unique_ptr<std::istream> stream, std::string_view n
     }
 }
 
-void FileReader::append(std::unique_ptr<std::istream> stream, std::string_view name_tag)
+void FileReader::append(std::shared_ptr<const SourceBuffer> source, std::string_view name_tag)
 {
-    append(std::move(stream), name_tag, [] {});
+    append(std::move(source), name_tag, [] {});
 }
 
-void FileReader::insert_now(std::unique_ptr<std::istream> stream, std::string_view name_tag,
+void FileReader::insert_now(std::shared_ptr<const SourceBuffer> source, std::string_view name_tag,
                             const std::function<void()>& callback)
 {
-
     if (contexts.empty())
     {
-        return append(std::move(stream), name_tag, callback);
+        return append(std::move(source), name_tag, callback);
     }
 
-    // As insert interrupts the current stream, the new stream is placed
-    // in front of the streams. After it is consumed, it will naturally
-    // go back to the previous streams, like in a stack.
+    // As insert interrupts the current source, the new source is placed
+    // in front of the sources. After it is consumed, it will naturally
+    // go back to the previous sources, like in a stack.
     auto stacked_name_tag = contexts.front().name_tag + "::" + std::string{name_tag};
-    contexts.emplace_front(std::move(stream), stacked_name_tag, callback);
+    contexts.emplace_front(std::move(source), stacked_name_tag, callback);
 
     auto context_count = contexts.size();
     exhausted = false;
@@ -52,16 +53,38 @@ void FileReader::insert_now(std::unique_ptr<std::istream> stream, std::string_vi
 
     if (contexts.size() == context_count)
     {
-        // The inserted stream was not empty, so there's a real interruption.
+        // The inserted source was not empty, so there's a real interruption.
         // If the new size had been different, it would have meant that the
-        // drop_front_empty_providers() had dropped an empty stream.
+        // drop_front_empty_providers() had dropped an empty source.
         interrupted = true;
     }
 }
 
+void FileReader::insert_now(std::shared_ptr<const SourceBuffer> source, std::string_view name_tag)
+{
+    insert_now(std::move(source), name_tag, [] {});
+}
+
+void FileReader::append(std::unique_ptr<std::istream> stream, std::string_view name_tag,
+                        const std::function<void()>& callback)
+{
+    append(SourceBuffer::from_stream(*stream), name_tag, callback);
+}
+
+void FileReader::append(std::unique_ptr<std::istream> stream, std::string_view name_tag)
+{
+    append(SourceBuffer::from_stream(*stream), name_tag);
+}
+
+void FileReader::insert_now(std::unique_ptr<std::istream> stream, std::string_view name_tag,
+                            const std::function<void()>& callback)
+{
+    insert_now(SourceBuffer::from_stream(*stream), name_tag, callback);
+}
+
 void FileReader::insert_now(std::unique_ptr<std::istream> stream, std::string_view name_tag)
 {
-    insert_now(std::move(stream), name_tag, [] {});
+    insert_now(SourceBuffer::from_stream(*stream), name_tag);
 }
 
 bool FileReader::content_exhausted() const { return exhausted; }
@@ -74,20 +97,20 @@ void FileReader::advance()
         return;
     }
 
-    assert(contexts.front().line_iterator != std::istream_iterator<line>());
+    assert(contexts.front().has_line);
     if (interrupted)
     {
-        // A new stream was added in front.
-        // In that case, advancing means advancing the interrupted stream and reading
-        // the first line of the new stream.
+        // A new source was added in front.
+        // In that case, advancing means advancing the interrupted source and reading
+        // the first line of the new source.
         assert(contexts.size() > 1);
-        ++contexts[1].line_iterator;
+        contexts[1].has_line = contexts[1].read_next_line();
         ++contexts[1].current_line_count;
         interrupted = false;
     }
     else
     {
-        ++contexts[0].line_iterator;
+        contexts[0].has_line = contexts[0].read_next_line();
         ++contexts[0].current_line_count;
     }
     drop_front_empty_providers();
@@ -135,15 +158,9 @@ bool operator!=(const FileReader::Iterator& a, const FileReader::Iterator& b)
     return (a.file_reader != b.file_reader) || (a.marker != b.marker);
 }
 
-std::istream& operator>>(std::istream& stream, line& line)
-{
-    std::getline(stream, line);
-    return stream;
-}
-
 void FileReader::drop_front_empty_providers()
 {
-    while (!contexts.empty() && (contexts.front().line_iterator == std::istream_iterator<line>()))
+    while (!contexts.empty() && !contexts.front().has_line)
     {
         auto& callback = contexts.front().callback;
         if (callback)
@@ -156,11 +173,15 @@ void FileReader::drop_front_empty_providers()
 
 void FileReader::extract_line_or_stop()
 {
-    if (!contexts.empty() && (contexts.front().line_iterator != std::istream_iterator<line>()))
+    if (!contexts.empty() && contexts.front().has_line)
     {
-        latest_read_line = *contexts.front().line_iterator;
+        latest_read_line = contexts.front().line;
         current_line_count = contexts.front().current_line_count;
         current_name_tag = contexts.front().name_tag;
+        if (current_source != contexts.front().source)
+        {
+            current_source = contexts.front().source;
+        }
     }
     else
     {
@@ -170,4 +191,19 @@ void FileReader::extract_line_or_stop()
 
 std::size_t FileReader::get_line_number() const { return current_line_count; }
 
-std::string FileReader::get_name_tag() const { return current_name_tag; }
+const std::string& FileReader::get_name_tag() const { return current_name_tag; }
+
+const std::shared_ptr<const SourceBuffer>& FileReader::get_current_source() const
+{
+    return current_source;
+}
+
+void FileReader::set_include_resolver(IncludeResolver resolver)
+{
+    include_resolver = std::move(resolver);
+}
+
+const FileReader::IncludeResolver& FileReader::get_include_resolver() const
+{
+    return include_resolver;
+}
@@ -1,19 +1,15 @@
 #ifndef INC_8008_ASSEMBLER_FILE_READER_H
 #define INC_8008_ASSEMBLER_FILE_READER_H
 
+#include "source_buffer.h"
+
 #include <cstdint>
 #include <deque>
 #include <functional>
 #include <iterator>
 #include <memory>
 #include <string>
-
-struct line : public std::string
-{
-    using std::string::string;
-};
-
-std::istream& operator>>(std::istream& stream, line& line);
+#include <string_view>
 
 class FileReader
 {
@@ -23,9 +19,9 @@ public:
     public:
         using iterator_category [[maybe_unused]] = std::input_iterator_tag;
         using difference_type [[maybe_unused]] = int;
-        using value_type = std::string;
-        using pointer = value_type*;
-        using reference = value_type&;
+        using value_type = std::string_view;
+        using pointer = const value_type*;
+        using reference = value_type;
 
         value_type operator*() const;
         Iterator& operator++();
@@ -48,29 +44,55 @@ public:
 
     [[nodiscard]] std::size_t get_line_number() const;
 
-    // Appends a new stream for queueing. It will be read after the already present streams.
+    // Appends a new source for queueing. It will be read after the already present sources.
+    void append(std::shared_ptr<const SourceBuffer> source, std::string_view name_tag);
+
+    void append(std::shared_ptr<const SourceBuffer> source, std::string_view name_tag,
+                const std::function<void()>& callback);
+
+    // Inserts a new source to be read just now. It interrupts the current source and will
+    // return to it after, as in a stack.
+    void insert_now(std::shared_ptr<const SourceBuffer> source, std::string_view name_tag);
+
+    void insert_now(std::shared_ptr<const SourceBuffer> source, std::string_view name_tag,
+                    const std::function<void()>& callback);
+
+    // Streams are fully read in memory and then act as sources.
     void append(std::unique_ptr<std::istream> stream, std::string_view name_tag);
 
     void append(std::unique_ptr<std::istream> stream, std::string_view name_tag,
                 const std::function<void()>& callback);
 
-    // Inserts a new stream to be read just now. It interrupts the current stream and will
-    // return to it after, as in a stack.
     void insert_now(std::unique_ptr<std::istream> stream, std::string_view name_tag);
 
     void insert_now(std::unique_ptr<std::istream> stream, std::string_view name_tag,
                     const std::function<void()>& callback);
 
-    [[nodiscard]] std::string get_name_tag() const;
+    [[nodiscard]] const std::string& get_name_tag() const;
+
+    // The source of the current line. The line stays valid as long as its source is held.
+    [[nodiscard]] const std::shared_ptr<const SourceBuffer>& get_current_source() const;
+
+    // Gives the source of an included file, or nullptr if it can't be found.
+    // Without a resolver, included files are read from the filesystem.
+    using IncludeResolver =
+            std::function<std::shared_ptr<const SourceBuffer>(const std::string& filename)>;
+    void set_include_resolver(IncludeResolver resolver);
+    [[nodiscard]] const IncludeResolver& get_include_resolver() const;
 
 private:
     struct ReaderContext
     {
-        ReaderContext(std::unique_ptr<std::istream>&& stream, std::string_view name_tag,
+        ReaderContext(std::shared_ptr<const SourceBuffer>&& source, std::string_view name_tag,
                       std::function<void()> callback);
 
-        std::unique_ptr<std::istream> input_stream;
-        std::istream_iterator<line> line_iterator;
+        // Reads the next line from the source. Returns false when the source is exhausted.
+        bool read_next_line();
+
+        std::shared_ptr<const SourceBuffer> source;
+        LineSplitter splitter;
+        std::string_view line;
+        bool has_line;
         std::size_t current_line_count;
         std::string name_tag;
         std::function<void()> callback;
@@ -80,8 +102,10 @@ private:
     std::size_t current_line_count{0};
     bool exhausted{true};
     bool interrupted{false};
-    line latest_read_line;
+    std::string_view latest_read_line;
     std::string current_name_tag;
+    std::shared_ptr<const SourceBuffer> current_source;
+    IncludeResolver include_resolver;
 
     [[nodiscard]] bool content_exhausted() const;
 
@@ -89,7 +113,7 @@ private:
     void drop_front_empty_providers();
     void extract_line_or_stop();
 
-    [[nodiscard]] const std::string& current_line() const { return latest_read_line; }
+    [[nodiscard]] std::string_view current_line() const { return latest_read_line; }
 };
 
 #endif //INC_8008_ASSEMBLER_FILE_READER_H
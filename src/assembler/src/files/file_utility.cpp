@@ -1,29 +1,31 @@
 #include "file_utility.h"
 
 #include "files.h"
+#include "file_cache.h"
 
 #include <memory>
 
 void Utility::append_file_by_name(FileReader& file_reader, const std::string& filename)
 {
-    auto stream = std::make_unique<std::ifstream>(filename.c_str());
+    auto source = FileCache::global().get(filename);
 
-    if (stream->fail())
+    if (!source)
     {
         throw CannotOpenFile(filename, "input file");
     }
 
-    file_reader.append(std::move(stream), filename);
+    file_reader.append(std::move(source), filename);
 }
 
 void Utility::insert_file_by_name(FileReader& file_reader, const std::string& filename)
 {
-    auto stream = std::make_unique<std::ifstream>(filename.c_str());
+    const auto& include_resolver = file_reader.get_include_resolver();
+    auto source = include_resolver ? include_resolver(filename) : FileCache::global().get(filename);
 
-    if (stream->fail())
+    if (!source)
     {
         throw CannotOpenFile(filename, "include file");
     }
 
-    file_reader.insert_now(std::move(stream), filename);
+    file_reader.insert_now(std::move(source), filename);
 }
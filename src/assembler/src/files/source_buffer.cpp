@@ -0,0 +1,124 @@
+#include "source_buffer.h"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ASSEMBLER_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::shared_ptr<const SourceBuffer> SourceBuffer::from_file(const std::string& filename)
+{
+    auto buffer = std::make_shared<MappedFileSourceBuffer>(filename);
+    if (!buffer->is_open())
+    {
+        return nullptr;
+    }
+    return buffer;
+}
+
+std::shared_ptr<const SourceBuffer> SourceBuffer::copy_file(const std::string& filename)
+{
+    std::ifstream stream{filename, std::ios::binary};
+    if (stream.fail())
+    {
+        return nullptr;
+    }
+    return from_stream(stream);
+}
+
+std::shared_ptr<const SourceBuffer> SourceBuffer::from_stream(std::istream& stream)
+{
+    std::ostringstream content;
+    content << stream.rdbuf();
+    return std::make_shared<StringSourceBuffer>(std::move(content).str());
+}
+
+std::shared_ptr<const SourceBuffer> SourceBuffer::from_string(std::string content)
+{
+    return std::make_shared<StringSourceBuffer>(std::move(content));
+}
+
+StringSourceBuffer::StringSourceBuffer(std::string content) : content{std::move(content)} {}
+
+std::string_view StringSourceBuffer::get_content() const { return content; }
+
+MappedFileSourceBuffer::MappedFileSourceBuffer(const std::string& filename)
+{
+#ifdef ASSEMBLER_USE_MMAP
+    const int file_descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+    {
+        return;
+    }
+
+    struct stat file_status{};
+    if (::fstat(file_descriptor, &file_status) == 0 && S_ISREG(file_status.st_mode))
+    {
+        mapped_size = static_cast<std::size_t>(file_status.st_size);
+
+        if (mapped_size > 0)
+        {
+            void* mapping =
+                    ::mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if (mapping != MAP_FAILED)
+            {
+                ::madvise(mapping, mapped_size, MADV_SEQUENTIAL);
+                mapped_data = static_cast<const char*>(mapping);
+                opened = true;
+            }
+            else
+            {
+                mapped_size = 0;
+            }
+        }
+    }
+    ::close(file_descriptor);
+
+    if (mapped_data == nullptr)
+    {
+        // Empty files have nothing to map, and some files (like pipes) can't be mapped.
+        read_file(filename);
+    }
+#else
+    read_file(filename);
+#endif
+}
+
+MappedFileSourceBuffer::~MappedFileSourceBuffer()
+{
+#ifdef ASSEMBLER_USE_MMAP
+    if (mapped_data != nullptr)
+    {
+        ::munmap(const_cast<char*>(mapped_data), mapped_size);
+    }
+#endif
+}
+
+void MappedFileSourceBuffer::read_file(const std::string& filename)
+{
+    std::ifstream stream{filename, std::ios::binary};
+    opened = !stream.fail();
+    if (opened)
+    {
+        read_content.assign(std::istreambuf_iterator<char>{stream},
+                            std::istreambuf_iterator<char>{});
+    }
+}
+
+bool MappedFileSourceBuffer::is_open() const { return opened; }
+
+std::string_view MappedFileSourceBuffer::get_content() const
+{
+    if (mapped_data != nullptr)
+    {
+        return {mapped_data, mapped_size};
+    }
+    return read_content;
+}
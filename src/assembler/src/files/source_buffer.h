@@ -0,0 +1,101 @@
+#ifndef INC_8008_ASSEMBLER_SOURCE_BUFFER_H
+#define INC_8008_ASSEMBLER_SOURCE_BUFFER_H
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// A SourceBuffer holds the whole content of an input. Lines are then read directly
+// from this content, without being copied.
+class SourceBuffer
+{
+public:
+    virtual ~SourceBuffer() = default;
+
+    [[nodiscard]] virtual std::string_view get_content() const = 0;
+
+    // Returns a buffer with the content of the file, or nullptr if the file can't be opened.
+    static std::shared_ptr<const SourceBuffer> from_file(const std::string& filename);
+    // The same, but the content is always read in memory, so it doesn't depend on the file
+    // once loaded. A mapped file truncated while it is mapped faults when read.
+    static std::shared_ptr<const SourceBuffer> copy_file(const std::string& filename);
+    static std::shared_ptr<const SourceBuffer> from_stream(std::istream& stream);
+    static std::shared_ptr<const SourceBuffer> from_string(std::string content);
+};
+
+// The content is owned as a string.
+class StringSourceBuffer : public SourceBuffer
+{
+public:
+    explicit StringSourceBuffer(std::string content);
+
+    [[nodiscard]] std::string_view get_content() const override;
+
+private:
+    std::string content;
+};
+
+// The content is mapped from a file when the platform allows it.
+// Otherwise, the file is read in memory.
+class MappedFileSourceBuffer : public SourceBuffer
+{
+public:
+    explicit MappedFileSourceBuffer(const std::string& filename);
+    MappedFileSourceBuffer(const MappedFileSourceBuffer&) = delete;
+    MappedFileSourceBuffer& operator=(const MappedFileSourceBuffer&) = delete;
+    ~MappedFileSourceBuffer() override;
+
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] std::string_view get_content() const override;
+
+private:
+    bool opened{false};
+    const char* mapped_data{nullptr};
+    std::size_t mapped_size{0};
+    std::string read_content;
+
+    void read_file(const std::string& filename);
+};
+
+// Splits a content in lines. A line ends with '\n' or at the end of the content,
+// and a final '\r' is removed from it. As with std::getline(), the content "a\n" is
+// one line, and an empty content has no line.
+class LineSplitter
+{
+public:
+    explicit LineSplitter(std::string_view content) : remaining{content} {}
+
+    // Returns false when the content is exhausted.
+    bool next_line(std::string_view& line)
+    {
+        if (remaining.empty())
+        {
+            return false;
+        }
+
+        const auto end_of_line = remaining.find('\n');
+        if (end_of_line == std::string_view::npos)
+        {
+            line = remaining;
+            remaining = {};
+        }
+        else
+        {
+            line = remaining.substr(0, end_of_line);
+            remaining.remove_prefix(end_of_line + 1);
+        }
+
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        return true;
+    }
+
+private:
+    std::string_view remaining;
+};
+
+#endif //INC_8008_ASSEMBLER_SOURCE_BUFFER_H
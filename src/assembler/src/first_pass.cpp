@@ -2,6 +2,7 @@
 
 #include "context.h"
 #include "errors.h"
+#include "files/file_cache.h"
 #include "files/file_reader.h"
 #include "instruction.h"
 #include "parsed_line.h"
@@ -14,27 +15,30 @@
 
 namespace
 {
-    void throws_if_already_defined(const Context& context, const std::string& label)
+    void throws_if_already_defined(const Context& context, std::string_view label,
+                                   SymbolTable::SymbolId label_id)
     {
-        if (auto symbol_value = context.get_symbol_value(label); std::get<0>(symbol_value))
+        if (auto symbol_value = context.get_symbol_value(label_id); std::get<0>(symbol_value))
         {
             throw AlreadyDefinedSymbol(label, std::get<1>(symbol_value));
         }
     }
 
-    void define_symbol_or_fail(Context& context, const std::string& label, const int line_address,
+    void define_symbol_or_fail(Context& context, std::string_view label, const int line_address,
                                const Instruction& instruction)
     {
         const auto& options = context.get_options();
 
-        throws_if_already_defined(context, label);
+        // The label is folded once, and then only its identifier is used.
+        const auto label_id = context.get_symbol_interner().intern(label);
+        throws_if_already_defined(context, label, label_id);
 
         auto optional_value = instruction.get_value_for_label(context, line_address);
 
         if (optional_value.has_value())
         {
             auto& value = optional_value.value();
-            context.define_symbol(label, value);
+            context.define_symbol(label_id, label, value);
 
             if (options.debug)
             {
@@ -46,29 +50,31 @@ namespace
         }
     }
 
-    void handle_potential_label(Context& context, const ParsedLine& parsed_line)
+    void handle_potential_label(Context& context, const ParsedLineStorage& parsed_lines)
     {
-        if (!parsed_line.tokens.label.empty())
+        const auto& label = parsed_lines.latest_tokens().label;
+        if (!label.empty())
         {
-            define_symbol_or_fail(context, parsed_line.tokens.label, parsed_line.line_address,
+            const auto parsed_line = parsed_lines.latest_line();
+            define_symbol_or_fail(context, label, parsed_line.line_address,
                                   parsed_line.instruction);
         }
     }
 
     bool is_exiting_macro(const ContextStack& context_stack, const ParsedLineStorage& parsed_lines)
     {
-        const auto& tokens = parsed_lines.latest_line().tokens;
+        const auto& tokens = parsed_lines.latest_tokens();
 
         return (context_stack.get_current_context()->get_parsing_mode() ==
                 Context::MACRO_RECORDING) &&
                ci_equals(tokens.opcode, ".endmacro");
     }
 
-    int first_pass_execution(ContextStack& context_stack, const ParsedLine& latest_parsed_line,
+    int first_pass_execution(ContextStack& context_stack, const ParsedLineStorage& parsed_lines,
                              int current_address)
     {
-        handle_potential_label(*context_stack.get_current_context(), latest_parsed_line);
-        const auto& instruction = latest_parsed_line.instruction;
+        handle_potential_label(*context_stack.get_current_context(), parsed_lines);
+        const auto& instruction = parsed_lines.latest_line().instruction;
         return instruction.first_pass(context_stack, current_address);
     }
 
@@ -87,7 +93,7 @@ void first_pass(ContextStack context_stack, FileReader& file_reader,
     }
 
     int current_address = 0;
-    for (const std::string& input_line : file_reader)
+    for (const std::string_view input_line : file_reader)
     {
         if (options.verbose || options.debug)
         {
@@ -106,9 +112,8 @@ void first_pass(ContextStack context_stack, FileReader& file_reader,
                     context_stack.get_current_context()->get_parsing_mode();
             if ((parsing_mode != Context::MACRO_RECORDING) || exiting_macro)
             {
-                const auto& latest_parsed_line = parsed_line_storage.latest_line();
                 current_address =
-                        first_pass_execution(context_stack, latest_parsed_line, current_address);
+                        first_pass_execution(context_stack, parsed_line_storage, current_address);
             }
             else
             {
@@ -121,9 +126,18 @@ void first_pass(ContextStack context_stack, FileReader& file_reader,
                                    input_line);
         }
     }
+
+    if (options.verbose || options.debug)
+    {
+        const auto statistics = FileCache::global().get_statistics();
+        const auto flags = std::cout.flags();
+        std::cout << std::dec << "File cache: " << statistics.hits << " hits, "
+                  << statistics.misses << " misses\n";
+        std::cout.flags(flags);
+    }
 }
 
-AlreadyDefinedSymbol::AlreadyDefinedSymbol(const std::string& symbol, int value)
+AlreadyDefinedSymbol::AlreadyDefinedSymbol(std::string_view symbol, int value)
 {
-    reason = "label '" + symbol + "' was already defined as " + std::to_string(value);
+    reason = "label '" + std::string{symbol} + "' was already defined as " + std::to_string(value);
 }
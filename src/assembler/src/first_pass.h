@@ -17,7 +17,7 @@ void first_pass(ContextStack context_stack, FileReader& file_reader, ParsedLineS
 class AlreadyDefinedSymbol : public ExceptionWithReason
 {
 public:
-    AlreadyDefinedSymbol(const std::string& symbol, int value);
+    AlreadyDefinedSymbol(std::string_view symbol, int value);
 };
 
 #endif //INC_8008_ASSEMBLER_FIRST_PASS_H
@@ -2,13 +2,17 @@
 #define INC_8008_ASSEMBLER_INSTRUCTION_H
 
 #include "errors.h"
+#include "instruction_actions.h"
+#include "line_tokenizer.h"
+#include "opcodes/opcodes.h"
 
-#include <memory>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
-#include <optional>
 
 class ByteWriter;
 class Context;
@@ -41,8 +45,11 @@ enum class InstructionEnum
 class Instruction
 {
 public:
-    Instruction(const Context& context, const std::string& label, const std::string& opcode,
-                const std::vector<std::string>& arguments, FileReader& file_reader);
+    // The buffers of the instruction are allocated from the memory resource, which must
+    // outlive it.
+    Instruction(const Context& context, std::string_view label, std::string_view opcode,
+                const LineTokenizer::Arguments& arguments, FileReader& file_reader,
+                std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource());
 
     [[nodiscard]] std::optional<int> get_value_for_label(const Context& context, int address) const;
 
@@ -50,44 +57,29 @@ public:
 
     void second_pass(const Context& context, ByteWriter& writer, int address) const;
 
-    void listing_pass(Listing& listing, const std::string& input_line, uint32_t line_number,
-                      int address) const;
-
-    class InstructionAction
-    {
-    public:
-        virtual ~InstructionAction() = default;
-
-        // This is used when there's a need of evaluation of an expression instruction like
-        // ORG or EQU, before the first pass.
-        // The default is to return the given address.
-        [[nodiscard]] virtual std::optional<int> evaluate_fixed_address(const Context& context,
-                                                                        int address) const;
-
-        // This is used by the first pass to know how many bytes are needed for this instruction.
-        // The default is a need of 0, and so returns the given address.
-        [[nodiscard]] virtual int advance_address(const Context& context, int address) const;
-
-        // Some instruction can modify the context_stack
-        virtual void update_context_stack(ContextStack& context_stack) const;
+    // The two steps of the second pass. Building only reads the symbols, so lines can be built
+    // in parallel, but their bytes must be written in order.
+    void build(const Context& context, int address) const;
+    void write_bytes(const Context& context, ByteWriter& writer, int address) const;
 
-        // If the construction needs information from the first pass, then it is constructed
-        // at build time.
-        virtual void build(const Context& context, int address);
+    void listing_pass(Listing& listing, std::string_view input_line, uint32_t line_number,
+                      int address) const;
 
-        // Write the bytes for the instruction to the ByteWriter.
-        // Currently, also emits the listing, it will have to go
-        virtual void write_bytes(const Context& context, ByteWriter& writer, int address) const;
+private:
+    const AnyInstructionAction action;
+};
 
-        virtual void write_listing(Listing& listing, const std::string& input_line,
-                                   uint32_t line_number, int address) const;
-    };
+// What the opcode of a line is, found with a single lookup of all the keywords of a syntax.
+// For CPU mnemonics, the index of the opcode in the opcode table of the syntax is given too.
+struct InstructionKind
+{
+    static constexpr std::size_t NO_OPCODE = std::numeric_limits<std::size_t>::max();
 
-private:
-    std::unique_ptr<InstructionAction> action;
+    InstructionEnum instruction;
+    std::size_t opcode_index{NO_OPCODE};
 };
 
-InstructionEnum instruction_to_enum(std::string_view opcode);
+InstructionKind classify_instruction(std::string_view opcode, SyntaxType syntax_type);
 
 class InvalidCPU : public ExceptionWithReason
 {
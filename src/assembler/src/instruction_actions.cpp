@@ -0,0 +1,424 @@
+#include "instruction_actions.h"
+#include "byte_writer.h"
+#include "context_stack.h"
+#include "data_extraction.h"
+#include "evaluation/evaluator.h"
+#include "files/file_utility.h"
+#include "instruction.h"
+#include "listing.h"
+#include "macro_content.h"
+#include "utils.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+std::optional<int> InstructionAction::evaluate_fixed_address(const Context& context,
+                                                             int address) const
+{
+    return address;
+}
+
+int InstructionAction::advance_address(const Context& context, int address) const
+{
+    return address;
+}
+
+void InstructionAction::build(const Context& context, int address) const
+{
+    // By default, nothing it built.
+}
+
+void InstructionAction::write_bytes(const Context& context, ByteWriter& writer,
+                                    int address) const
+{
+    // By default, doesn't write anything.
+}
+
+void InstructionAction::write_listing(Listing& listing, std::string_view input_line,
+                                      uint32_t line_number, int address) const
+{
+    listing.simple_line(line_number, input_line);
+}
+
+void InstructionAction::update_context_stack(ContextStack& context_stack) const {}
+
+Validated_Instruction::Validated_Instruction(std::string_view name,
+                                             const LineTokenizer::Arguments& arguments)
+{
+    if (arguments.empty())
+    {
+        throw MissingArgument(name);
+    }
+}
+
+Instruction_EQU::Instruction_EQU(const Context& context, const LineTokenizer::Arguments& arguments,
+                                 std::pmr::memory_resource* memory_resource)
+    : Validated_Instruction("EQU", arguments),
+      first_arg{std::pmr::polymorphic_allocator<>{memory_resource}.new_object<CompiledExpression>(
+                        context, arguments[0], memory_resource),
+                MemoryResourceDeleter{memory_resource}}
+{
+}
+
+std::optional<int> Instruction_EQU::evaluate_fixed_address(const Context& context,
+                                                           int current_address) const
+{
+    return first_arg->evaluate(context);
+}
+
+Instruction_CPU::Instruction_CPU(const LineTokenizer::Arguments& arguments)
+    : Validated_Instruction("CPU", arguments)
+{
+    verify_cpu(arguments[0]);
+}
+
+void Instruction_CPU::verify_cpu(std::string_view cpu_arg)
+{
+    if ((!ci_equals(cpu_arg, "8008")) && (!ci_equals(cpu_arg, "i8008")))
+    {
+        throw InvalidCPU();
+    }
+}
+
+Instruction_ORG::Instruction_ORG(const Context& context, const LineTokenizer::Arguments& arguments)
+    : Validated_Instruction("ORG", arguments)
+{
+    evaluated_argument = evaluate_argument(context, arguments[0]);
+}
+
+std::optional<int> Instruction_ORG::evaluate_fixed_address(const Context& context,
+                                                           int current_address) const
+{
+    return evaluated_argument;
+}
+
+int Instruction_ORG::advance_address(const Context& context, int current_address) const
+{
+    return evaluated_argument;
+}
+
+Instruction_DATA::Instruction_DATA(const Context& context,
+                                   const LineTokenizer::Arguments& arguments,
+                                   std::pmr::memory_resource* memory_resource)
+    : data_list{memory_resource}
+{
+    data_size = decode_data(context, arguments, data_list);
+
+    if (context.get_options().debug)
+    {
+        std::cout << "got " << std::dec << std::abs(data_size) << " items in data list\n";
+    }
+}
+
+int Instruction_DATA::advance_address(const Context& context, int current_address) const
+{
+    /* a negative number denotes that much space to save, but not specifying data */
+    return current_address + std::abs(data_size);
+}
+
+void Instruction_DATA::write_bytes(const Context& context, ByteWriter& writer, int address) const
+{
+    for (int write_address = address; const auto& data : data_list)
+    {
+        writer.write_byte(data, write_address);
+        write_address += 1;
+    }
+}
+
+void Instruction_DATA::write_listing(Listing& listing, std::string_view input_line,
+                                     uint32_t line_number, int address) const
+{
+    if (data_size < 0)
+    {
+        /* if n is negative, that number of bytes are just reserved */
+        listing.reserved_data(line_number, address, input_line);
+    }
+    else
+    {
+        listing.data(line_number, address, input_line, data_list);
+    }
+}
+
+Instruction_OTHER::Instruction_OTHER(const Context& context, std::string_view opcode_string,
+                                     std::size_t opcode_index,
+                                     const LineTokenizer::Arguments& token_arguments,
+                                     SyntaxType syntax_type,
+                                     std::pmr::memory_resource* memory_resource)
+    : arguments{memory_resource}
+{
+    if (context.get_options().debug)
+    {
+        std::cout << "\n";
+    }
+
+    if (opcode_index == InstructionKind::NO_OPCODE)
+    {
+        throw UndefinedOpcode(opcode_string);
+    }
+
+    const std::span<const std::string_view> argument_views{token_arguments.data(),
+                                                           token_arguments.size()};
+    const auto [found_opcode, consumed] =
+            decode_opcode(syntax_type, opcode_index, opcode_string, argument_views);
+    opcode = found_opcode;
+
+    // The arguments left are expressions, compiled once here.
+    assert(consumed <= argument_views.size());
+    arguments.reserve(argument_views.size() - consumed);
+    for (const auto argument : argument_views.subspan(consumed))
+    {
+        arguments.emplace_back(context, argument, memory_resource);
+    }
+}
+
+int Instruction_OTHER::advance_address(const Context& context, int current_address) const
+{
+    return current_address + get_opcode_size(opcode);
+}
+
+void Instruction_OTHER::build(const Context& context, int address) const
+{
+    opcode_action.emplace(create_opcode_action(context, opcode, address, arguments));
+}
+
+void Instruction_OTHER::write_bytes(const Context& context, ByteWriter& writer, int address) const
+{
+    emit_byte_stream(*opcode_action, writer);
+}
+
+void Instruction_OTHER::write_listing(Listing& listing, std::string_view input_line,
+                                      uint32_t line_number, int address) const
+{
+    emit_listing(*opcode_action, listing, line_number, input_line);
+}
+
+Instruction_INCLUDE::Instruction_INCLUDE(const Context& context,
+                                         const LineTokenizer::Arguments& arguments,
+                                         FileReader& file_reader)
+    : Validated_Instruction(".include", arguments)
+{
+    const auto& include_filename = arguments[0];
+
+    if (context.get_options().debug)
+    {
+        std::cout << "got '" << include_filename << "' as a filename to include.\n";
+    }
+
+    Utility::insert_file_by_name(file_reader, std::string{include_filename});
+}
+
+Instruction_SYNTAX::Instruction_SYNTAX(const Context& context,
+                                       const LineTokenizer::Arguments& arguments)
+    : Validated_Instruction(".syntax", arguments)
+{
+    const auto& syntax_type = arguments[0];
+
+    if (context.get_options().debug)
+    {
+        std::cout << "got '" << syntax_type << "' as the new syntax.\n";
+    }
+
+    verify_syntax(syntax_type);
+    new_syntax = ci_equals(syntax_type, "NEW");
+}
+
+void Instruction_SYNTAX::verify_syntax(std::string_view syntax)
+{
+    if ((!ci_equals(syntax, "OLD")) && (!ci_equals(syntax, "NEW")))
+    {
+        throw InvalidSyntax();
+    }
+}
+
+void Instruction_SYNTAX::update_context_stack(ContextStack& context_stack) const
+{
+    // The syntax instruction changes the current syntax mode.
+    context_stack.get_current_context()->get_options().new_syntax = new_syntax;
+    InstructionAction::update_context_stack(context_stack);
+}
+
+Instruction_CONTEXT::Instruction_CONTEXT(const Context& context,
+                                         const LineTokenizer::Arguments& arguments)
+    : Validated_Instruction(".context", arguments)
+{
+    const auto& context_action = arguments[0];
+
+    if (context.get_options().debug)
+    {
+        std::cout << "got '" << context_action << "' as the context action.\n";
+    }
+
+    verify_syntax(context_action);
+    action = ci_equals(context_action, "POP") ? POP : PUSH;
+}
+
+void Instruction_CONTEXT::verify_syntax(std::string_view syntax)
+{
+    if ((!ci_equals(syntax, "PUSH")) && (!ci_equals(syntax, "POP")))
+    {
+        throw InvalidContextAction();
+    }
+}
+
+void Instruction_CONTEXT::update_context_stack(ContextStack& context_stack) const
+{
+    switch (action)
+    {
+        case PUSH:
+            context_stack.push();
+            break;
+        case POP:
+            context_stack.pop();
+            break;
+    }
+    InstructionAction::update_context_stack(context_stack);
+}
+
+Instruction_IF::Instruction_IF(const Context& context, const LineTokenizer::Arguments& arguments)
+    : Validated_Instruction(".if", arguments)
+{
+    evaluated_argument = evaluate_argument(context, arguments[0]);
+}
+
+void Instruction_IF::update_context_stack(ContextStack& context_stack) const
+{
+    context_stack.push();
+    context_stack.get_current_context()->set_parsing_mode(
+            evaluated_argument ? Context::CONDITIONAL_TRUE : Context::CONDITIONAL_FALSE);
+    InstructionAction::update_context_stack(context_stack);
+}
+
+Instruction_ELSE::Instruction_ELSE(const Context& context)
+{
+    previous_mode = context.get_parsing_mode();
+
+    if (previous_mode != Context::ParsingMode::CONDITIONAL_TRUE &&
+        previous_mode != Context::ParsingMode::CONDITIONAL_FALSE)
+    {
+        throw InvalidConditional(".else");
+    }
+}
+
+void Instruction_ELSE::update_context_stack(ContextStack& context_stack) const
+{
+    context_stack.get_current_context()->set_parsing_mode(
+            previous_mode == Context::CONDITIONAL_TRUE ? Context::CONDITIONAL_FALSE
+                                                       : Context::CONDITIONAL_TRUE);
+    InstructionAction::update_context_stack(context_stack);
+}
+
+Instruction_ENDIF::Instruction_ENDIF(const Context& context)
+{
+    auto previous_mode = context.get_parsing_mode();
+
+    if (previous_mode != Context::ParsingMode::CONDITIONAL_TRUE &&
+        previous_mode != Context::ParsingMode::CONDITIONAL_FALSE)
+    {
+        throw InvalidConditional(".endif");
+    }
+}
+
+void Instruction_ENDIF::update_context_stack(ContextStack& context_stack) const
+{
+    context_stack.pop();
+    InstructionAction::update_context_stack(context_stack);
+}
+
+Instruction_MACRO::Instruction_MACRO(const Context& context, std::string_view macro_name,
+                                     const LineTokenizer::Arguments& arguments)
+    : name{macro_name}
+{
+    if (context.get_options().debug)
+    {
+        std::cout << "start recording macro: " << macro_name << "\n";
+    }
+
+    formal_parameters.assign(std::begin(arguments), std::end(arguments));
+}
+
+std::optional<int> Instruction_MACRO::evaluate_fixed_address(const Context& context,
+                                                             int address) const
+{
+    return {};
+}
+
+void Instruction_MACRO::update_context_stack(ContextStack& context_stack) const
+{
+    context_stack.push();
+    auto context = context_stack.get_current_context();
+    context->start_macro(name, formal_parameters);
+    InstructionAction::update_context_stack(context_stack);
+}
+
+Instruction_ENDMACRO::Instruction_ENDMACRO(const Context& context)
+{
+    auto previous_mode = context.get_parsing_mode();
+
+    if (previous_mode != Context::ParsingMode::MACRO_RECORDING)
+    {
+        throw InvalidEndmacro();
+    }
+
+    if (context.get_options().debug)
+    {
+        std::cout << "stop recording macro\n";
+    }
+}
+
+void Instruction_ENDMACRO::update_context_stack(ContextStack& context_stack) const
+{
+    context_stack.get_current_context()->stop_macro();
+    context_stack.pop();
+    InstructionAction::update_context_stack(context_stack);
+}
+
+Instruction_MACRO_CALL::Instruction_MACRO_CALL(const Context& context,
+                                               std::string_view command_string,
+                                               const LineTokenizer::Arguments& arguments,
+                                               FileReader& file_reader)
+    : file_reader{file_reader}
+{
+    std::string macro_name{command_string.substr(1)};
+    if (!context.has_macro(macro_name))
+    {
+        throw UndefinedMacro(command_string);
+    }
+
+    macro_content = context.get_macro_content(macro_name);
+
+    actual_parameters.assign(std::begin(arguments), std::end(arguments));
+
+    if (context.get_options().debug)
+    {
+        std::cout << "start playing macro: " << macro_name << "\n";
+    }
+
+    assert(macro_content != nullptr);
+}
+
+void Instruction_MACRO_CALL::update_context_stack(ContextStack& context_stack) const
+{
+    assert(macro_content != nullptr);
+
+    const auto expected_parameter_count = macro_content->get_parameters().size();
+    const auto actual_parameter_count = actual_parameters.size();
+
+    if (expected_parameter_count != actual_parameter_count)
+    {
+        throw WrongNumberOfParameters(macro_content->get_name(), expected_parameter_count,
+                                      actual_parameter_count);
+    }
+    context_stack.push();
+    context_stack.get_current_context()->call_macro(macro_content, actual_parameters,
+                                                    file_reader,
+                                                    [&context_stack] { context_stack.pop(); });
+}
+
+Instruction_EMPTY::Instruction_EMPTY(const Context& context)
+{
+    if (context.get_options().debug)
+    {
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,248 @@
+#ifndef INC_8008_ASSEMBLER_INSTRUCTION_ACTIONS_H
+#define INC_8008_ASSEMBLER_INSTRUCTION_ACTIONS_H
+
+#include "context.h"
+#include "evaluation/compiled_expression.h"
+#include "line_tokenizer.h"
+#include "opcodes/any_opcode_action.h"
+#include "opcodes/opcodes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+class ByteWriter;
+class ContextStack;
+class FileReader;
+class Listing;
+class MacroContent;
+
+// Destroys an object allocated from a memory resource, and gives its memory back.
+struct MemoryResourceDeleter
+{
+    std::pmr::memory_resource* memory_resource;
+
+    template<typename T>
+    void operator()(T* object) const
+    {
+        std::pmr::polymorphic_allocator<>{memory_resource}.delete_object(object);
+    }
+};
+
+// What an instruction does in each pass. The actions are not virtual: an action hides the
+// defaults it replaces, and the calls are dispatched on the alternative of AnyInstructionAction.
+// The actions needing buffers allocate them from the memory resource of the assembly.
+struct InstructionAction
+{
+    // This is used when there's a need of evaluation of an expression instruction like
+    // ORG or EQU, before the first pass.
+    // The default is to return the given address.
+    [[nodiscard]] std::optional<int> evaluate_fixed_address(const Context& context,
+                                                            int address) const;
+
+    // This is used by the first pass to know how many bytes are needed for this instruction.
+    // The default is a need of 0, and so returns the given address.
+    [[nodiscard]] int advance_address(const Context& context, int address) const;
+
+    // Some instruction can modify the context_stack
+    void update_context_stack(ContextStack& context_stack) const;
+
+    // If the construction needs information from the first pass, then it is constructed
+    // at build time.
+    void build(const Context& context, int address) const;
+
+    // Write the bytes for the instruction to the ByteWriter.
+    // Currently, also emits the listing, it will have to go
+    void write_bytes(const Context& context, ByteWriter& writer, int address) const;
+
+    void write_listing(Listing& listing, std::string_view input_line, uint32_t line_number,
+                       int address) const;
+};
+
+struct Validated_Instruction : public InstructionAction
+{
+    Validated_Instruction(std::string_view name, const LineTokenizer::Arguments& arguments);
+};
+
+struct Instruction_EQU : public Validated_Instruction
+{
+    Instruction_EQU(const Context& context, const LineTokenizer::Arguments& arguments,
+                    std::pmr::memory_resource* memory_resource);
+
+    [[nodiscard]] std::optional<int> evaluate_fixed_address(const Context& context,
+                                                            int current_address) const;
+
+    // The expression is large, so it is allocated apart to keep the actions small.
+    std::unique_ptr<CompiledExpression, MemoryResourceDeleter> first_arg;
+};
+
+struct Instruction_END : public InstructionAction
+{
+    // For END, we could stock the evaluation, but rather than that
+    // we will go ahead and check for more.
+    // Said otherwise: END is ignored.
+};
+
+struct Instruction_CPU : public Validated_Instruction
+{
+    explicit Instruction_CPU(const LineTokenizer::Arguments& arguments);
+
+    static void verify_cpu(std::string_view cpu_arg);
+};
+
+struct Instruction_ORG : public Validated_Instruction
+{
+    Instruction_ORG(const Context& context, const LineTokenizer::Arguments& arguments);
+
+    [[nodiscard]] std::optional<int> evaluate_fixed_address(const Context& context,
+                                                            int current_address) const;
+    [[nodiscard]] int advance_address(const Context& context, int current_address) const;
+
+    int evaluated_argument;
+};
+
+struct Instruction_DATA : public InstructionAction
+{
+    Instruction_DATA(const Context& context, const LineTokenizer::Arguments& arguments,
+                     std::pmr::memory_resource* memory_resource);
+
+    [[nodiscard]] int advance_address(const Context& context, int current_address) const;
+    void write_bytes(const Context& context, ByteWriter& writer, int address) const;
+    void write_listing(Listing& listing, std::string_view input_line, uint32_t line_number,
+                       int address) const;
+
+    std::pmr::vector<int> data_list;
+    int data_size; // Can be negative in case of uninitialized data reservation.
+};
+
+struct Instruction_OTHER : public InstructionAction
+{
+    // The opcode was already looked up when the instruction was classified.
+    Instruction_OTHER(const Context& context, std::string_view opcode_string,
+                      std::size_t opcode_index, const LineTokenizer::Arguments& token_arguments,
+                      SyntaxType syntax_type, std::pmr::memory_resource* memory_resource);
+
+    [[nodiscard]] int advance_address(const Context& context, int current_address) const;
+    void build(const Context& context, int address) const;
+    void write_bytes(const Context& context, ByteWriter& writer, int address) const;
+    void write_listing(Listing& listing, std::string_view input_line, uint32_t line_number,
+                       int address) const;
+
+    std::pmr::vector<CompiledExpression> arguments;
+    // Empty until the line is built. Building stores it, but the line stays const for the
+    // passes.
+    mutable std::optional<AnyOpcodeAction> opcode_action;
+    Opcode opcode;
+};
+
+struct Instruction_INCLUDE : public Validated_Instruction
+{
+    Instruction_INCLUDE(const Context& context, const LineTokenizer::Arguments& arguments,
+                        FileReader& file_reader);
+};
+
+struct Instruction_SYNTAX : public Validated_Instruction
+{
+    Instruction_SYNTAX(const Context& context, const LineTokenizer::Arguments& arguments);
+
+    static void verify_syntax(std::string_view syntax);
+
+    void update_context_stack(ContextStack& context_stack) const;
+
+    bool new_syntax{};
+};
+
+struct Instruction_CONTEXT : public Validated_Instruction
+{
+    Instruction_CONTEXT(const Context& context, const LineTokenizer::Arguments& arguments);
+
+    static void verify_syntax(std::string_view syntax);
+
+    void update_context_stack(ContextStack& context_stack) const;
+
+    enum Action
+    {
+        PUSH,
+        POP
+    };
+
+    Action action;
+};
+
+struct Instruction_IF : public Validated_Instruction
+{
+    Instruction_IF(const Context& context, const LineTokenizer::Arguments& arguments);
+
+    void update_context_stack(ContextStack& context_stack) const;
+
+    int evaluated_argument;
+};
+
+struct Instruction_ELSE : public InstructionAction
+{
+    explicit Instruction_ELSE(const Context& context);
+
+    void update_context_stack(ContextStack& context_stack) const;
+
+    Context::ParsingMode previous_mode;
+};
+
+struct Instruction_ENDIF : public InstructionAction
+{
+    explicit Instruction_ENDIF(const Context& context);
+
+    void update_context_stack(ContextStack& context_stack) const;
+};
+
+struct Instruction_MACRO : public InstructionAction
+{
+    Instruction_MACRO(const Context& context, std::string_view macro_name,
+                      const LineTokenizer::Arguments& arguments);
+
+    [[nodiscard]] std::optional<int> evaluate_fixed_address(const Context& context,
+                                                            int address) const;
+    void update_context_stack(ContextStack& context_stack) const;
+
+    std::string name;
+    std::vector<std::string> formal_parameters;
+};
+
+struct Instruction_ENDMACRO : public InstructionAction
+{
+    explicit Instruction_ENDMACRO(const Context& context);
+
+    void update_context_stack(ContextStack& context_stack) const;
+};
+
+struct Instruction_MACRO_CALL : public InstructionAction
+{
+    Instruction_MACRO_CALL(const Context& context, std::string_view command_string,
+                           const LineTokenizer::Arguments& arguments, FileReader& file_reader);
+
+    void update_context_stack(ContextStack& context_stack) const;
+
+    FileReader& file_reader;
+    std::vector<std::string> actual_parameters;
+    MacroContent* macro_content{};
+};
+
+struct Instruction_EMPTY : public InstructionAction
+{
+    explicit Instruction_EMPTY(const Context& context);
+};
+
+// The action of a line, held by value in the line itself.
+using AnyInstructionAction =
+        std::variant<Instruction_EMPTY, Instruction_EQU, Instruction_END, Instruction_CPU,
+                     Instruction_ORG, Instruction_DATA, Instruction_INCLUDE, Instruction_SYNTAX,
+                     Instruction_CONTEXT, Instruction_IF, Instruction_ELSE, Instruction_ENDIF,
+                     Instruction_MACRO, Instruction_ENDMACRO, Instruction_MACRO_CALL,
+                     Instruction_OTHER>;
+
+#endif //INC_8008_ASSEMBLER_INSTRUCTION_ACTIONS_H
@@ -1,62 +1,123 @@
 #include "line_tokenizer.h"
+#include "character_classifier.h"
 #include "options.h"
 #include "utils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <utility>
 
 namespace
 {
-    struct LineParser
+    // Scans the line once. The tokens are views on the line, except for the rare arguments
+    // that need to be joined, which are kept in the joined arguments.
+    class LineParser
     {
-        explicit LineParser(std::string_view view) : view{view} {}
+    public:
+        LineParser(std::string_view line,
+                   std::shared_ptr<std::deque<std::string>>& joined_arguments)
+            : line{line}, view{line}, classifier{line}, joined_arguments{joined_arguments}
+        {
+        }
 
-        std::string next_word() { return next_with_delimiters(" \t;"); }
-        std::string next_argument()
+        std::string_view next_word()
         {
-            std::string result;
+            return next_with_delimiters(CharacterClasses::BLANK | CharacterClasses::SEMICOLON);
+        }
+        std::string_view next_argument()
+        {
+            ArgumentBuilder result;
 
             while (!view.empty())
             {
                 if ((view.front() == '\'') || (view.front() == '"'))
                 {
-                    result += next_quoted_string();
+                    result.append(next_quoted_string());
 
                     if (is_comment() || is_comma())
                     {
-                        view = view.substr(1);
-                        return result;
+                        view.remove_prefix(1);
+                        return result.get(joined_arguments);
                     }
                 }
                 else
                 {
-                    result += next_with_delimiters(",;\"'");
-                    return result;
+                    result.append(next_with_delimiters(CharacterClasses::COMMA |
+                                                       CharacterClasses::SEMICOLON |
+                                                       CharacterClasses::QUOTE));
+                    return result.get(joined_arguments);
                 }
             }
 
-            return result;
+            return result.get(joined_arguments);
         }
         [[nodiscard]] bool empty() const { return view.empty(); }
 
     private:
+        // The parts of an argument are views on the line. Most of the time, they follow
+        // each other and the argument stays a view on the line.
+        class ArgumentBuilder
+        {
+        public:
+            void append(std::string_view part)
+            {
+                if (part.empty())
+                {
+                    return;
+                }
+                const bool follows = argument.data() + argument.size() == part.data();
+                if (!joined && (argument.empty() || follows))
+                {
+                    argument = {argument.empty() ? part.data() : argument.data(),
+                                argument.size() + part.size()};
+                    return;
+                }
+                if (!joined)
+                {
+                    joined_argument = argument;
+                    joined = true;
+                }
+                joined_argument += part;
+            }
+
+            std::string_view get(std::shared_ptr<std::deque<std::string>>& joined_arguments)
+            {
+                if (!joined)
+                {
+                    return argument;
+                }
+                if (!joined_arguments)
+                {
+                    joined_arguments = std::make_shared<std::deque<std::string>>();
+                }
+                // The strings of a deque don't move when another one is added.
+                return joined_arguments->emplace_back(std::move(joined_argument));
+            }
+
+        private:
+            std::string_view argument;
+            bool joined{false};
+            std::string joined_argument;
+        };
+
         [[nodiscard]] bool is_comment() const { return !view.empty() && view.front() == ';'; }
         [[nodiscard]] bool is_comma() const { return !view.empty() && view.front() == ','; }
 
-        std::string next_with_delimiters(std::string_view delimiters)
+        std::string_view next_with_delimiters(unsigned delimiters)
         {
             skip_spaces();
-            if (is_comment())
+            if (view.empty() || is_comment())
             {
                 return consume_full_view();
             }
 
-            auto first_delimiter = view.find_first_of(delimiters);
-            if (first_delimiter == std::string::npos)
+            const auto delimiter_position = classifier.find_first_of(position(), delimiters);
+            if (delimiter_position == std::string_view::npos)
             {
                 return consume_full_view();
             }
+            const auto first_delimiter = delimiter_position - position();
             if (view[first_delimiter] == ';')
             {
                 return consume_view_and_keep_next(first_delimiter);
@@ -64,7 +125,7 @@ namespace
             return consume_view_and_skip_next(first_delimiter);
         }
 
-        std::string next_quoted_string()
+        std::string_view next_quoted_string()
         {
             const char quote_type = view.front();
             for (std::size_t index = 1; index < view.length(); index += 1)
@@ -84,41 +145,56 @@ namespace
 
         void skip_spaces()
         {
-            auto first_not_space = view.find_first_not_of(" \t");
-            if (first_not_space != std::string::npos)
+            // Most of the time, there is no space to skip.
+            if (view.empty() || (view.front() != ' ' && view.front() != '\t'))
             {
-                view = view.substr(first_not_space);
+                return;
+            }
+
+            const auto first_not_space =
+                    classifier.find_first_not_of(position(), CharacterClasses::BLANK);
+            if (first_not_space != std::string_view::npos)
+            {
+                view.remove_prefix(first_not_space - position());
             }
             else
             {
-                view.resize(0);
+                view = {};
             }
         }
 
-        std::string consume_full_view()
+        // The position of the view in the line.
+        [[nodiscard]] std::size_t position() const { return view.data() - line.data(); }
+
+        std::string_view consume_full_view()
         {
             auto result = view;
-            view.resize(0);
-            return std::string{trim_string(result)};
+            view = {};
+            return trim_string(result);
         }
 
-        std::string consume_view_and_skip_next(std::size_t length_to_consume)
+        std::string_view consume_view_and_skip_next(std::size_t length_to_consume)
         {
             auto result = view.substr(0, length_to_consume);
-            view = view.substr(std::min(length_to_consume + 1, view.size()));
-            return std::string{trim_string(result)};
+            view.remove_prefix(std::min(length_to_consume + 1, view.size()));
+            return trim_string(result);
         }
 
-        std::string consume_view_and_keep_next(std::size_t length_to_consume)
+        std::string_view consume_view_and_keep_next(std::size_t length_to_consume)
         {
             assert(length_to_consume > 0);
             auto result = view.substr(0, length_to_consume);
-            view = view.substr(std::min(length_to_consume, view.size()));
-            return std::string{trim_string(result)};
+            view.remove_prefix(std::min(length_to_consume, view.size()));
+            return trim_string(result);
         }
 
-        std::string view;
+        std::string_view line;
+        std::string_view view;
+        CharacterClassifier classifier;
+        std::shared_ptr<std::deque<std::string>>& joined_arguments;
     };
+
+    bool is_comment(std::string_view token) { return !token.empty() && token.front() == ';'; }
 }
 
 LineTokenizer::LineTokenizer(const std::string_view line)
@@ -131,18 +207,18 @@ LineTokenizer::LineTokenizer(const std::string_view line)
     auto first_char = line[0];
     auto used_first_column = (first_char != ' ') && (first_char != '\t') && (first_char != 0x00);
 
-    LineParser line_parser{line};
+    LineParser line_parser{line, joined_arguments};
 
     if (used_first_column)
     {
         auto next = line_parser.next_word();
 
-        if (next.front() == ';')
+        if (is_comment(next))
         {
-            comment = std::move(next);
+            comment = next;
             return;
         }
-        label = std::move(next);
+        label = next;
         adjust_label();
     }
 
@@ -150,36 +226,41 @@ LineTokenizer::LineTokenizer(const std::string_view line)
     {
         auto next = line_parser.next_word();
 
-        if (next.front() == ';')
+        if (is_comment(next))
         {
-            comment = std::move(next);
+            comment = next;
             return;
         }
-        opcode = std::move(next);
+        opcode = next;
     }
 
     while (!line_parser.empty())
     {
         auto next = line_parser.next_argument();
 
-        if (next.front() == ';')
+        if (is_comment(next))
         {
-            comment = std::move(next);
+            comment = next;
             return;
         }
         if (!next.empty())
         {
-            arguments.push_back(std::move(next));
+            arguments.push_back(next);
         }
     }
 }
 
 void LineTokenizer::adjust_label()
 {
+    if (label.empty())
+    {
+        return;
+    }
+
     const char last_label_char = label.back();
     if (last_label_char == ':' || last_label_char == ',')
     {
-        label.resize(label.size() - 1);
+        label.remove_suffix(1);
     }
     else if (ci_equals(label, "equ"))
     {
@@ -200,7 +281,13 @@ LineTokenizer parse_line(const Options& options, const std::string_view line,
                          std::size_t line_count)
 {
     LineTokenizer tokens(line);
+    report_tokens(options, tokens, line, line_count);
+    return tokens;
+}
 
+void report_tokens(const Options& options, const LineTokenizer& tokens, std::string_view line,
+                   std::size_t line_count)
+{
     if (tokens.warning_on_label)
     {
         std::cerr << "WARNING: in line " << line_count << " " << line << " label " << tokens.label
@@ -227,6 +314,4 @@ LineTokenizer parse_line(const Options& options, const std::string_view line,
 
         std::cout << "\n";
     }
-
-    return tokens;
 }
\ No newline at end of file
@@ -1,28 +1,44 @@
 #ifndef INC_8008_ASSEMBLER_LINE_TOKENIZER_H
 #define INC_8008_ASSEMBLER_LINE_TOKENIZER_H
 
+#include "small_vector.h"
+
 #include <deque>
+#include <memory>
 #include <string>
-#include <vector>
+#include <string_view>
 
 class Options;
 
+// Splits a line in tokens. The tokens are views on the line, which must outlive them.
 class LineTokenizer
 {
 public:
+    // Most instructions have at most two arguments.
+    using Arguments = SmallVector<std::string_view, 2>;
+
     explicit LineTokenizer(std::string_view line);
 
-    std::string label;
-    std::string opcode;
-    std::vector<std::string> arguments;
-    std::string comment;
+    std::string_view label;
+    std::string_view opcode;
+    Arguments arguments;
+    std::string_view comment;
 
     bool warning_on_label{false};
 
 private:
     void adjust_label();
+
+    // An argument made of a quoted part followed by spaces and an expression is joined
+    // without the spaces, so it isn't a view on the line anymore. It is then kept here,
+    // shared between the copies of the tokens.
+    std::shared_ptr<std::deque<std::string>> joined_arguments;
 };
 
 LineTokenizer parse_line(const Options& options, std::string_view line, std::size_t line_count);
 
+// Outputs the warnings and the debug information about tokens parsed from a line.
+void report_tokens(const Options& options, const LineTokenizer& tokens, std::string_view line,
+                   std::size_t line_count);
+
 #endif //INC_8008_ASSEMBLER_LINE_TOKENIZER_H
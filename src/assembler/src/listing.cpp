@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <ranges>
@@ -15,8 +16,16 @@ Listing::Listing(std::ostream& output, const Options& options) : output(output),
 
 void Listing::write_listing_header()
 {
-    time_t result = time(nullptr);
-    std::string compile_time{asctime(localtime(&result))};
+    const time_t result = time(nullptr);
+    std::tm local_time{};
+#ifdef _WIN32
+    localtime_s(&local_time, &result);
+#else
+    localtime_r(&result, &local_time);
+#endif
+    // Same format as asctime(), which isn't thread safe.
+    std::ostringstream compile_time;
+    compile_time << std::put_time(&local_time, "%a %b %e %H:%M:%S %Y\n");
 
     output << "8008 Assembler, s.glaize Version 1.0\n";
     output << "Originally based on AS8 assembler by t.e.jones Version 1.0\n";
@@ -27,7 +36,7 @@ void Listing::write_listing_header()
     output << "octalnums=" << options.input_num_as_octal << " markascii=" << options.mark_8_ascii
            << "\n";
     output << "Infile=" << options.input_filenames.front() << "\n";
-    output << "Assembly Performed: " << compile_time << "\n\n";
+    output << "Assembly Performed: " << compile_time.str() << "\n\n";
     if (options.single_byte_list)
     {
         output << "Line Addr.  DAT Source Line\n";
@@ -40,7 +49,7 @@ void Listing::write_listing_header()
     }
 }
 
-void Listing::simple_line(uint32_t line_number, const std::string& line_content)
+void Listing::simple_line(uint32_t line_number, std::string_view line_content)
 {
     const auto& short_format = options.single_byte_list;
     ListingLine line{line_number};
@@ -52,7 +61,7 @@ void Listing::simple_line(uint32_t line_number, const std::string& line_content)
     output << line.str() << "\n";
 }
 
-void Listing::reserved_data(uint32_t line_number, int line_address, const std::string& line_content)
+void Listing::reserved_data(uint32_t line_number, int line_address, std::string_view line_content)
 {
     const auto& short_format = options.single_byte_list;
     ListingLine line{line_number, line_address};
@@ -115,8 +124,8 @@ void Listing::one_byte_of_data_continued(int line_address, int data) const
     output << line.str() << "\n";
 }
 
-void Listing::data(std::uint32_t line_number, int line_address, const std::string& line_content,
-                   const std::vector<int>& data_list)
+void Listing::data(std::uint32_t line_number, int line_address, std::string_view line_content,
+                   std::span<const int> data_list)
 {
     if (options.single_byte_list)
     {
@@ -4,7 +4,8 @@
 #include "opcodes/opcodes.h"
 
 #include <cstdint>
-#include <vector>
+#include <span>
+#include <string_view>
 
 class Options;
 
@@ -13,11 +14,11 @@ class Listing
 public:
     Listing(std::ostream& output, const Options& options);
     void write_listing_header();
-    void simple_line(uint32_t line_number, const std::string& line_content);
-    void data(std::uint32_t line_number, int line_address, const std::string& line_content,
-              const std::vector<int>& data_list);
+    void simple_line(uint32_t line_number, std::string_view line_content);
+    void data(std::uint32_t line_number, int line_address, std::string_view line_content,
+              std::span<const int> data_list);
 
-    void reserved_data(uint32_t line_number, int line_address, const std::string& line_content);
+    void reserved_data(uint32_t line_number, int line_address, std::string_view line_content);
     void one_byte_of_data_with_address(std::uint32_t line_number, int line_address, int data,
                                        std::string_view line_content) const;
     void one_byte_of_data_continued(int line_address, int data) const;
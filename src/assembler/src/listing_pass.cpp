@@ -21,7 +21,7 @@ void listing_pass(const Options& global_options, ParsedLineStorage& parsed_line_
 
     listing.write_listing_header();
 
-    for (auto& parsed_line : parsed_line_storage)
+    for (const auto parsed_line : parsed_line_storage)
     {
         const auto& input_line = parsed_line.line;
         const auto line_number = parsed_line.line_number;
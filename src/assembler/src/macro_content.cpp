@@ -1,8 +1,9 @@
 #include "macro_content.h"
 
+#include "utils.h"
+
 #include <algorithm>
 #include <ranges>
-#include <sstream>
 
 MacroContent::MacroContent(std::string_view name, const Parameters& parameters) : name{name}
 {
@@ -22,13 +23,61 @@ std::string_view MacroContent::get_name() const { return name; }
 
 const MacroContent::Parameters& MacroContent::get_parameters() const { return parameters; }
 
+std::size_t MacroContent::find_parameter(std::string_view parameter_name) const
+{
+    // When a parameter name is repeated, the last one is used.
+    for (std::size_t index = parameters.size(); index > 0; index -= 1)
+    {
+        if (ci_equals(parameters[index - 1], parameter_name))
+        {
+            return index - 1;
+        }
+    }
+    return LineTemplate::NO_PARAMETER;
+}
+
 void MacroContent::append_line(std::string_view line)
 {
     content += line;
     content += '\n';
+    body.reset();
+    line_templates.clear();
+}
+
+const std::shared_ptr<const SourceBuffer>& MacroContent::get_body()
+{
+    if (!body)
+    {
+        body = SourceBuffer::from_string(content);
+        make_line_templates();
+    }
+    return body;
 }
 
-std::unique_ptr<std::istringstream> MacroContent::get_line_stream()
+void MacroContent::make_line_templates()
 {
-    return std::make_unique<std::istringstream>(content);
+    // The tokens are views on the body, which is kept as long as the templates.
+    LineSplitter splitter{body->get_content()};
+    std::string_view line;
+    while (splitter.next_line(line))
+    {
+        LineTemplate line_template{LineTokenizer{line}, {}};
+        line_template.parameter_indices.reserve(line_template.tokens.arguments.size());
+        for (const auto& argument : line_template.tokens.arguments)
+        {
+            line_template.parameter_indices.push_back(find_parameter(argument));
+        }
+        line_templates.push_back(std::move(line_template));
+    }
+}
+
+const MacroContent::LineTemplate*
+MacroContent::get_line_template(const std::shared_ptr<const SourceBuffer>& source,
+                                std::size_t line_number) const
+{
+    if (!body || source != body || line_number == 0 || line_number > line_templates.size())
+    {
+        return nullptr;
+    }
+    return &line_templates[line_number - 1];
 }
@@ -1,6 +1,10 @@
 #ifndef INC_8008_ASSEMBLER_MACRO_CONTENT_H
 #define INC_8008_ASSEMBLER_MACRO_CONTENT_H
 
+#include "files/source_buffer.h"
+#include "line_tokenizer.h"
+
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -10,20 +14,43 @@ class MacroContent
 {
 public:
     using Parameters = std::vector<std::string>;
+
+    // A line of the macro, tokenized once for all the calls. Each argument token is associated
+    // to the index of the parameter it names, or to NO_PARAMETER.
+    struct LineTemplate
+    {
+        static constexpr std::size_t NO_PARAMETER = static_cast<std::size_t>(-1);
+
+        LineTokenizer tokens;
+        std::vector<std::size_t> parameter_indices;
+    };
+
     MacroContent(std::string_view name, const Parameters& parameters);
 
     [[nodiscard]] std::string_view get_name() const;
     [[nodiscard]] const Parameters& get_parameters() const;
 
+    // Returns the index of the parameter with this name, or LineTemplate::NO_PARAMETER.
+    [[nodiscard]] std::size_t find_parameter(std::string_view parameter_name) const;
+
     void append_line(std::string_view line);
 
-    std::unique_ptr<std::istringstream> get_line_stream();
+    // The recorded lines, as a source to insert in a FileReader.
+    const std::shared_ptr<const SourceBuffer>& get_body();
+
+    // Returns the template of a line of the body, or nullptr if the source isn't the body.
+    [[nodiscard]] const LineTemplate* get_line_template(
+            const std::shared_ptr<const SourceBuffer>& source, std::size_t line_number) const;
 
 private:
+    void make_line_templates();
+
     std::string name;
     Parameters parameters;
 
     std::string content;
+    std::shared_ptr<const SourceBuffer> body;
+    std::vector<LineTemplate> line_templates;
 };
 
 #endif //INC_8008_ASSEMBLER_MACRO_CONTENT_H
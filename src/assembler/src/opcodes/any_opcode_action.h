@@ -0,0 +1,28 @@
+#ifndef INC_8008_ASSEMBLER_ANY_OPCODE_ACTION_H
+#define INC_8008_ASSEMBLER_ANY_OPCODE_ACTION_H
+
+#include "opcode_action.h"
+#include "opcode_action_inpout.h"
+#include "opcode_action_noarg.h"
+#include "opcode_action_onebyte_arg.h"
+#include "opcode_action_rst.h"
+#include "opcode_action_twobyte_arg.h"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <variant>
+
+// The action of an opcode, held by value. The set of actions is closed, so the calls are
+// dispatched on the alternative rather than through a virtual table.
+using AnyOpcodeAction = std::variant<OpcodeActionNoArg, OpcodeActionOneByteArg,
+                                     OpcodeActionTwoByteArg, OpcodeActionInpOut, OpcodeActionRst>;
+
+AnyOpcodeAction create_opcode_action(const Context& context, Opcode opcode, int address,
+                                     std::span<const CompiledExpression> arguments);
+
+void emit_byte_stream(const AnyOpcodeAction& action, ByteWriter& byte_writer);
+void emit_listing(const AnyOpcodeAction& action, Listing& listing, std::uint32_t line_number,
+                  std::string_view input_line);
+
+#endif //INC_8008_ASSEMBLER_ANY_OPCODE_ACTION_H
@@ -1,14 +1,10 @@
 #include "opcode_action.h"
+#include "any_opcode_action.h"
 
 #include "byte_writer.h"
-#include "evaluation/evaluator.h"
 #include "listing.h"
 
-#include "opcode_action_inpout.h"
-#include "opcode_action_noarg.h"
-#include "opcode_action_onebyte_arg.h"
-#include "opcode_action_rst.h"
-#include "opcode_action_twobyte_arg.h"
+#include <cassert>
 
 namespace
 {
@@ -21,9 +17,8 @@ namespace
     }
 }
 
-std::unique_ptr<OpcodeAction> create_opcode_action(const Context& context, Opcode opcode,
-                                                   int address,
-                                                   const std::vector<std::string>& arguments)
+AnyOpcodeAction create_opcode_action(const Context& context, Opcode opcode, int address,
+                                     std::span<const CompiledExpression> arguments)
 {
     if (correct_argument_count(opcode, arguments.size()))
     {
@@ -33,20 +28,33 @@ std::unique_ptr<OpcodeAction> create_opcode_action(const Context& context, Opcod
     switch (opcode.rule)
     {
         case NO_ARG:
-            return std::make_unique<OpcodeActionNoArg>(opcode.code, address);
+            return OpcodeActionNoArg{opcode.code, address};
         case ONE_BYTE_ARG:
-            return std::make_unique<OpcodeActionOneByteArg>(context, opcode.code, address,
-                                                            arguments);
+            return OpcodeActionOneByteArg{context, opcode.code, address, arguments};
         case ADDRESS_ARG:
-            return std::make_unique<OpcodeActionTwoByteArg>(context, opcode.code, address,
-                                                            arguments);
+            return OpcodeActionTwoByteArg{context, opcode.code, address, arguments};
         case INP_OUT:
-            return std::make_unique<OpcodeActionInpOut>(context, opcode.code, address, arguments,
-                                                        opcode.mnemonic);
+            return OpcodeActionInpOut{context, opcode.code, address, arguments, opcode.mnemonic};
         case RST:
-            return std::make_unique<OpcodeActionRst>(context, opcode.code, address, arguments);
+            return OpcodeActionRst{context, opcode.code, address, arguments};
     }
-    return nullptr;
+    assert(0 && "Missing case in the OpcodeAction Factory.");
+    return OpcodeActionNoArg{opcode.code, address};
+}
+
+void emit_byte_stream(const AnyOpcodeAction& action, ByteWriter& byte_writer)
+{
+    std::visit([&byte_writer](const auto& opcode_action)
+               { opcode_action.emit_byte_stream(byte_writer); },
+               action);
+}
+
+void emit_listing(const AnyOpcodeAction& action, Listing& listing, std::uint32_t line_number,
+                  std::string_view input_line)
+{
+    std::visit([&](const auto& opcode_action)
+               { opcode_action.emit_listing(listing, line_number, input_line); },
+               action);
 }
 
 ExpectedArgumentWithinLimits::ExpectedArgumentWithinLimits(int limit, const std::string& content,
@@ -61,7 +69,7 @@ UnexpectedArgumentCount::UnexpectedArgumentCount(uint32_t arg_count)
     reason = "unexpected number of arguments: " + std::to_string(arg_count);
 }
 
-int OpcodeAction::evaluate(const Context& context, std::string_view arg)
+int OpcodeAction::evaluate(const Context& context, const CompiledExpression& argument)
 {
-    return evaluate_argument(context, arg);
+    return argument.evaluate(context);
 }
@@ -4,32 +4,24 @@
 #include "opcodes.h"
 
 #include "context.h"
+#include "evaluation/compiled_expression.h"
 #include "options.h"
 #include "symbol_table.h"
 
-#include <memory>
+#include <span>
 #include <string>
-#include <vector>
 
 class ByteWriter;
 class Listing;
 
+// The base of the actions of the opcodes. The actions are not virtual: each one provides
+// emit_byte_stream() and emit_listing(), called through AnyOpcodeAction.
 class OpcodeAction
 {
 public:
-    virtual void emit_byte_stream(ByteWriter& byte_writer) const = 0;
-    virtual void emit_listing(Listing& listing, std::uint32_t line_number,
-                              std::string_view input_line) const = 0;
-
-    virtual ~OpcodeAction() = default;
-
-    static int evaluate(const Context& context, std::string_view arg);
+    static int evaluate(const Context& context, const CompiledExpression& argument);
 };
 
-std::unique_ptr<OpcodeAction> create_opcode_action(const Context& context, Opcode opcode,
-                                                   int address,
-                                                   const std::vector<std::string>& arguments);
-
 class ExpectedArgumentWithinLimits : public ExceptionWithReason
 {
 public:
@@ -4,7 +4,8 @@
 #include "listing.h"
 
 OpcodeActionInpOut::OpcodeActionInpOut(const Context& context, Opcode::OpcodeByteType opcode_byte,
-                                       int address, const std::vector<std::string>& arguments,
+                                       int address,
+                                       std::span<const CompiledExpression> arguments,
                                        std::string_view mnemonic)
     : address{address}
 {
@@ -14,7 +15,7 @@ OpcodeActionInpOut::OpcodeActionInpOut(const Context& context, Opcode::OpcodeByt
 
     if ((argument > max_port) || (argument < 0))
     {
-        throw ExpectedArgumentWithinLimits(max_port, arguments[0], argument);
+        throw ExpectedArgumentWithinLimits(max_port, arguments[0].get_text(), argument);
     }
 
     opcode = opcode_byte + (argument << 1) + (is_input ? 0 : 16);
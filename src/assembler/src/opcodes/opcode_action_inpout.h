@@ -7,11 +7,12 @@ class OpcodeActionInpOut : public OpcodeAction
 {
 public:
     OpcodeActionInpOut(const Context& context, Opcode::OpcodeByteType opcode_byte, int address,
-                       const std::vector<std::string>& arguments, std::string_view mnemonic);
+                       std::span<const CompiledExpression> arguments,
+                       std::string_view mnemonic);
 
-    void emit_byte_stream(ByteWriter& byte_writer) const override;
+    void emit_byte_stream(ByteWriter& byte_writer) const;
     void emit_listing(Listing& listing, std::uint32_t line_number,
-                      std::string_view input_line) const override;
+                      std::string_view input_line) const;
 
 private:
     Opcode::OpcodeByteType opcode;
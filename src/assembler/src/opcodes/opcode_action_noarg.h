@@ -8,9 +8,9 @@ class OpcodeActionNoArg : public OpcodeAction
 public:
     explicit OpcodeActionNoArg(Opcode::OpcodeByteType opcode_byte, int address);
 
-    void emit_byte_stream(ByteWriter& byte_writer) const override;
+    void emit_byte_stream(ByteWriter& byte_writer) const;
     void emit_listing(Listing& listing, std::uint32_t line_number,
-                      std::string_view input_line) const override;
+                      std::string_view input_line) const;
 
 private:
     Opcode::OpcodeByteType opcode;
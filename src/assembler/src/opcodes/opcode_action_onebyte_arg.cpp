@@ -5,13 +5,13 @@
 
 OpcodeActionOneByteArg::OpcodeActionOneByteArg(const Context& context,
                                                Opcode::OpcodeByteType opcode_byte, int address,
-                                               const std::vector<std::string>& arguments)
+                                               std::span<const CompiledExpression> arguments)
     : opcode{opcode_byte}, address{address}
 {
     evaluated_argument = evaluate(context, arguments[0]);
     if ((evaluated_argument > 255) || (evaluated_argument < 0))
     {
-        throw ExpectedArgumentWithinLimits(255, arguments[0], evaluated_argument);
+        throw ExpectedArgumentWithinLimits(255, arguments[0].get_text(), evaluated_argument);
     }
 }
 
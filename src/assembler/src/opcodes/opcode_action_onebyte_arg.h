@@ -8,11 +8,11 @@ class OpcodeActionOneByteArg : public OpcodeAction
 {
 public:
     OpcodeActionOneByteArg(const Context& context, Opcode::OpcodeByteType opcode_byte, int address,
-                           const std::vector<std::string>& arguments);
+                           std::span<const CompiledExpression> arguments);
 
-    void emit_byte_stream(ByteWriter& byte_writer) const override;
+    void emit_byte_stream(ByteWriter& byte_writer) const;
     void emit_listing(Listing& listing, std::uint32_t line_number,
-                      std::string_view input_line) const override;
+                      std::string_view input_line) const;
 
 private:
     Opcode::OpcodeByteType opcode;
@@ -4,7 +4,7 @@
 #include "listing.h"
 
 OpcodeActionRst::OpcodeActionRst(const Context& context, Opcode::OpcodeByteType opcode_byte,
-                                 int address, const std::vector<std::string>& arguments)
+                                 int address, std::span<const CompiledExpression> arguments)
     : opcode{opcode_byte}, address{address}
 {
     int argument = evaluate(context, arguments[0]);
@@ -14,7 +14,7 @@ OpcodeActionRst::OpcodeActionRst(const Context& context, Opcode::OpcodeByteType
     }
     if ((argument > 7) || (argument < 0))
     {
-        throw ExpectedArgumentWithinLimits(7, arguments[0], argument);
+        throw ExpectedArgumentWithinLimits(7, arguments[0].get_text(), argument);
     }
 
     this->opcode = (opcode | (argument << 3));
@@ -5,14 +5,15 @@
 
 OpcodeActionTwoByteArg::OpcodeActionTwoByteArg(const Context& context,
                                                Opcode::OpcodeByteType opcode_byte, int address,
-                                               const std::vector<std::string>& arguments)
+                                               std::span<const CompiledExpression> arguments)
     : opcode{opcode_byte}, address{address}
 {
     const int MAX_ADDRESS = 1024 * 16 - 1;
     evaluated_argument = evaluate(context, arguments[0]);
     if ((evaluated_argument > MAX_ADDRESS) || (evaluated_argument < 0))
     {
-        throw ExpectedArgumentWithinLimits(MAX_ADDRESS, arguments[0], evaluated_argument);
+        throw ExpectedArgumentWithinLimits(MAX_ADDRESS, arguments[0].get_text(),
+                                           evaluated_argument);
     }
 }
 
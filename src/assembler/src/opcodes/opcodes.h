@@ -33,10 +33,11 @@ struct Opcode
 
 int get_opcode_size(const Opcode& opcode);
 
-using matcher_signature = std::tuple<bool, Opcode, std::size_t>(std::string_view opcode_name,
-                                                                std::span<std::string> arguments);
-
-matcher_signature* get_opcode_matcher(SyntaxType syntax_type);
+// Decodes the opcode at an index of the opcode table of a syntax, when the mnemonic was
+// already looked up. Returns the opcode and the number of consumed arguments.
+std::tuple<Opcode, std::size_t> decode_opcode(SyntaxType syntax_type, std::size_t opcode_index,
+                                              std::string_view opcode_name,
+                                              std::span<const std::string_view> arguments);
 
 class UndefinedOpcode : public ExceptionWithReason
 {
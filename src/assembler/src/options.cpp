@@ -1,6 +1,7 @@
 #include "options.h"
 
 #include <algorithm>
+#include <charconv>
 #include <iostream>
 #include <ranges>
 #include <string_view>
@@ -10,9 +11,14 @@ const char* InvalidCommandLine::what() const noexcept { return "Invalid Command
 
 void Options::parse(int argc, const char** argv)
 {
-    auto file_count = parse_command_line(argc, argv);
+    const std::vector<std::string_view> arguments{argv + 1, argv + argc};
+    auto file_count = parse_command_line(argv[0], arguments);
     if (file_count == 0)
     {
+        if (!batch_filename.empty() || !server_socket_name.empty())
+        {
+            return;
+        }
         display_help(argv);
         throw InvalidCommandLine();
     }
@@ -20,9 +26,53 @@ void Options::parse(int argc, const char** argv)
     adjust_filenames();
 }
 
-std::size_t Options::parse_command_line(int argc, const char** argv)
+void Options::parse_batch_job(std::string_view job_line)
+{
+    std::vector<std::string_view> arguments;
+    while (!job_line.empty())
+    {
+        const auto start = job_line.find_first_not_of(" \t");
+        if (start == std::string_view::npos)
+        {
+            break;
+        }
+        job_line.remove_prefix(start);
+        const auto end = std::min(job_line.find_first_of(" \t"), job_line.size());
+        arguments.push_back(job_line.substr(0, end));
+        job_line.remove_prefix(end);
+    }
+
+    parse_job(arguments);
+    if (input_filenames.empty())
+    {
+        std::cerr << "a batch job needs input files\n";
+        throw InvalidCommandLine();
+    }
+}
+
+void Options::parse_job(const std::vector<std::string_view>& arguments)
+{
+    input_filenames.clear();
+    output_filename_base.clear();
+    batch_filename.clear();
+    server_socket_name.clear();
+
+    parse_command_line("a job", arguments);
+    if (!batch_filename.empty() || !server_socket_name.empty())
+    {
+        std::cerr << "a job can't be a batch or a server\n";
+        throw InvalidCommandLine();
+    }
+
+    if (!input_filenames.empty())
+    {
+        adjust_filenames();
+    }
+}
+
+std::size_t Options::parse_command_line(std::string_view program_name,
+                                        const std::vector<std::string_view>& arguments)
 {
-    std::vector<std::string_view> argv_vector{argv, argv + argc};
     std::vector<std::string_view> left_arguments{};
 
     bool as8options = false;
@@ -38,9 +88,12 @@ std::size_t Options::parse_command_line(int argc, const char** argv)
                                             {"-as8", &as8options, true},
                                             {"-syntax=new", &new_syntax, true},
                                             {"-syntax=old", &new_syntax, false},
-                                            {"-o", &output_name, true}};
+                                            {"-o", &output_name, true},
+                                            {"-batch", &batch_name, true},
+                                            {"-threads", &thread_count_value, true},
+                                            {"--serve", &server_name, true}};
 
-    for (auto& arg : argv_vector | std::ranges::views::drop(1))
+    for (auto& arg : arguments)
     {
         if (arg[0] == '-')
         {
@@ -54,7 +107,7 @@ std::size_t Options::parse_command_line(int argc, const char** argv)
             else
             {
                 std::cerr << "unknown option " << arg << "\n";
-                std::cerr << "    type " << argv_vector[0] << " for usage" << std::endl;
+                std::cerr << "    type " << program_name << " for usage" << std::endl;
             }
         }
         else
@@ -64,6 +117,27 @@ std::size_t Options::parse_command_line(int argc, const char** argv)
                 output_filename_base = arg;
                 output_name = false;
             }
+            else if (batch_name)
+            {
+                batch_filename = arg;
+                batch_name = false;
+            }
+            else if (server_name)
+            {
+                server_socket_name = arg;
+                server_name = false;
+            }
+            else if (thread_count_value)
+            {
+                const auto [end, error] =
+                        std::from_chars(arg.data(), arg.data() + arg.size(), thread_count);
+                if (error != std::errc{} || end != arg.data() + arg.size())
+                {
+                    std::cerr << "invalid thread count " << arg << "\n";
+                    thread_count = 0;
+                }
+                thread_count_value = false;
+            }
             else
             {
                 left_arguments.push_back(arg);
@@ -103,6 +177,9 @@ void Options::display_help(const char** argv)
     fprintf(stderr, "    -markascii  makes highest bit in ascii bytes a one (mark).\n");
     fprintf(stderr, "    -syntax=new default parsing is with new syntax mnemonics.\n");
     fprintf(stderr, "    -o          the next argument is the output filename base.\n");
+    fprintf(stderr, "    -batch      the next argument is a file listing jobs to assemble.\n");
+    fprintf(stderr, "    -threads    the next argument is the number of threads to assemble with.\n");
+    fprintf(stderr, "    --serve     the next argument is the socket of an assembler server.\n");
 }
 
 void Options::adjust_filenames()
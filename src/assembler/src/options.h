@@ -3,6 +3,7 @@
 
 #include <exception>
 #include <string>
+#include <string_view>
 #include <vector>
 
 class InvalidCommandLine : std::exception
@@ -16,6 +17,14 @@ public:
     Options() = default;
     void parse(int argc, const char** argv);
 
+    // Parses the arguments of a job from a batch file. The options already set are
+    // the defaults of the job.
+    void parse_batch_job(std::string_view job_line);
+
+    // Parses the arguments of a job. The options already set are the defaults of the job.
+    // The job may have no input file, when its inputs are given in another way.
+    void parse_job(const std::vector<std::string_view>& arguments);
+
 public:
     bool verbose = false;
     bool generate_list_file = true;
@@ -32,8 +41,18 @@ public:
     std::vector<std::string> input_filenames;
     std::string output_filename_base;
 
+    std::string batch_filename;
+    std::size_t thread_count = 0; // Zero uses all the hardware threads.
+
+    std::string server_socket_name;
+
 private:
-    std::size_t parse_command_line(int argc, const char** argv);
+    bool batch_name = false;
+    bool server_name = false;
+    bool thread_count_value = false;
+
+    std::size_t parse_command_line(std::string_view program_name,
+                                   const std::vector<std::string_view>& arguments);
     static void display_help(const char** argv);
     void adjust_filenames();
 };
@@ -2,21 +2,22 @@
 #define INC_8008_ASSEMBLER_PARSED_LINE_H
 
 #include "instruction.h"
-#include "line_tokenizer.h"
 
-#include <memory>
+#include <cstdint>
+#include <string_view>
 
 class Context;
 
+// A line of the ParsedLineStorage, as seen when walking it. It refers to the storage, and is
+// only valid as long as no line is appended.
 struct ParsedLine
 {
-    std::size_t line_number;
+    std::uint32_t line_number;
     int line_address;
-    LineTokenizer tokens;
-    Instruction instruction;
-    std::string line;
-    std::shared_ptr<std::string> name_tag;
-    std::shared_ptr<Context> context;
+    const Instruction& instruction;
+    std::string_view line; // Points in a source held by the ParsedLineStorage.
+    std::string_view name_tag;
+    const Context& context;
 };
 
 #endif //INC_8008_ASSEMBLER_PARSED_LINE_H
@@ -5,38 +5,105 @@
 #include "instruction.h"
 #include "line_tokenizer.h"
 
+ParsedLineStorage::ParsedLineStorage(std::pmr::memory_resource* upstream)
+    : arena{upstream}, instructions{&arena}
+{
+}
+
 void ParsedLineStorage::append_line(const std::shared_ptr<Context>& context,
                                     FileReader& file_reader, std::string_view input_line,
                                     std::size_t line_number, int address)
 {
-    auto name_tag_ref = get_name_tag_ref(file_reader.get_name_tag());
+    const auto name_tag = get_name_tag_index(file_reader.get_name_tag());
+    retain_source(file_reader.get_current_source());
+
+    // Lines from a macro body were tokenized when the body was made.
+    const auto* line_template =
+            context->get_macro_line_template(file_reader.get_current_source(), line_number);
+
+    LineTokenizer tokens = line_template ? line_template->tokens : LineTokenizer{input_line};
+    report_tokens(context->get_options(), tokens, input_line, line_number);
+    context->substitute_macro_arguments(line_template, tokens.arguments);
+    instructions.emplace_back(*context, tokens.label, tokens.opcode, tokens.arguments,
+                              file_reader, &arena);
+
+    line_numbers.push_back(static_cast<std::uint32_t>(line_number));
+    line_addresses.push_back(address);
+    lines.push_back(input_line);
+    name_tag_indices.push_back(name_tag);
+    context_indices.push_back(get_context_index(context));
+    tokens_of_latest_line = std::move(tokens);
+}
+
+std::size_t ParsedLineStorage::size() const { return lines.size(); }
+
+ParsedLine ParsedLineStorage::operator[](std::size_t index) const
+{
+    return {line_numbers[index],
+            line_addresses[index],
+            instructions[index],
+            lines[index],
+            name_tags[name_tag_indices[index]],
+            *contexts[context_indices[index]]};
+}
+
+ParsedLine ParsedLineStorage::latest_line() const { return (*this)[size() - 1]; }
+
+const LineTokenizer& ParsedLineStorage::latest_tokens() const { return *tokens_of_latest_line; }
 
-    LineTokenizer tokens = parse_line(context->get_options(), input_line, line_number);
-    context->replace_macro_tokens(tokens.arguments);
-    Instruction instruction{*context, tokens.label, tokens.opcode, tokens.arguments, file_reader};
-    parsed_lines.push_back({line_number, address, tokens, std::move(instruction),
-                            std::string{input_line}, name_tag_ref, context});
+std::size_t ParsedLineStorage::get_memory_usage() const
+{
+    auto vector_bytes = [](const auto& vector) {
+        return vector.capacity() * sizeof(typename std::decay_t<decltype(vector)>::value_type);
+    };
+    return vector_bytes(line_numbers) + vector_bytes(line_addresses) +
+           instructions.size() * sizeof(Instruction) + vector_bytes(lines) +
+           vector_bytes(name_tag_indices) + vector_bytes(context_indices) + vector_bytes(contexts) +
+           vector_bytes(sources);
 }
 
-std::shared_ptr<std::string> ParsedLineStorage::get_name_tag_ref(const std::string& name_tag)
+ParsedLineStorage::Iterator ParsedLineStorage::begin() const { return {*this, 0}; }
+ParsedLineStorage::Iterator ParsedLineStorage::end() const { return {*this, size()}; }
+
+void ParsedLineStorage::retain_source(const std::shared_ptr<const SourceBuffer>& source)
 {
-    auto where = std::find_if(std::begin(name_tags), std::end(name_tags),
-                              [&name_tag](auto& name) { return *name == name_tag; });
+    // Consecutive lines mostly come from the same source.
+    if (sources.empty() || sources.back() != source)
+    {
+        sources.push_back(source);
+    }
+}
 
-    std::shared_ptr<std::string> name_tag_ref;
-    if (where != std::end(name_tags))
+std::uint32_t ParsedLineStorage::get_name_tag_index(const std::string& name_tag)
+{
+    // Consecutive lines mostly come from the same file.
+    if (!name_tag_indices.empty() && name_tags[name_tag_indices.back()] == name_tag)
     {
-        name_tag_ref = *where;
+        return name_tag_indices.back();
     }
-    else
+
+    if (auto it = name_tag_index.find(name_tag); it != std::end(name_tag_index))
     {
-        name_tags.push_back(std::make_shared<std::string>(name_tag));
-        name_tag_ref = name_tags.back();
+        return it->second;
     }
-    return name_tag_ref;
+    const auto index = static_cast<std::uint32_t>(name_tags.size());
+    name_tags.push_back(name_tag);
+    name_tag_index.emplace(name_tags.back(), index);
+    return index;
 }
 
-const ParsedLine& ParsedLineStorage::latest_line() const { return parsed_lines.back(); }
+std::uint32_t ParsedLineStorage::get_context_index(const std::shared_ptr<Context>& context)
+{
+    if (!context_indices.empty() && contexts[context_indices.back()] == context)
+    {
+        return context_indices.back();
+    }
 
-ParsedLineStorage::Iterator ParsedLineStorage::begin() { return std::begin(parsed_lines); }
-ParsedLineStorage::Iterator ParsedLineStorage::end() { return std::end(parsed_lines); }
+    const auto [it, inserted] =
+            context_index.try_emplace(context.get(), static_cast<std::uint32_t>(contexts.size()));
+    if (inserted)
+    {
+        contexts.push_back(context);
+    }
+    return it->second;
+}
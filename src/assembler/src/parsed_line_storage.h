@@ -2,31 +2,102 @@
 #define INC_8008_ASSEMBLER_PARSED_LINE_STORAGE_H
 
 #include "context.h"
+#include "line_tokenizer.h"
 #include "parsed_line.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 class Context;
 class FileReader;
+class SourceBuffer;
 
+// The lines of an assembly, stored field by field. The name tags and the contexts, shared by
+// many lines, are stored once and referred to by their index.
+//
+// The buffers of the instructions are allocated from a monotonic arena which lives as long as
+// the storage, so they are released at once, when the assembly is over.
 class ParsedLineStorage
 {
 public:
+    // The arena takes its blocks from the upstream resource.
+    explicit ParsedLineStorage(
+            std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
     void append_line(const std::shared_ptr<Context>& context, FileReader& file_reader, std::string_view input_line,
                      std::size_t line_number, int address);
 
-    [[nodiscard]] const ParsedLine& latest_line() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] ParsedLine operator[](std::size_t index) const;
+    [[nodiscard]] ParsedLine latest_line() const;
+
+    // Only the tokens of the latest line are kept, as the first pass needs them once.
+    [[nodiscard]] const LineTokenizer& latest_tokens() const;
+
+    // The bytes held for the lines and their actions, without the sources and the buffers
+    // owned by the actions.
+    [[nodiscard]] std::size_t get_memory_usage() const;
+
+    class Iterator
+    {
+    public:
+        Iterator(const ParsedLineStorage& storage, std::size_t index)
+            : storage{&storage}, index{index}
+        {
+        }
+
+        ParsedLine operator*() const { return (*storage)[index]; }
+        Iterator& operator++()
+        {
+            index += 1;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const = default;
+
+    private:
+        const ParsedLineStorage* storage;
+        std::size_t index;
+    };
 
-    using Iterator = std::vector<ParsedLine>::iterator;
-    Iterator begin();
-    Iterator end();
+    [[nodiscard]] Iterator begin() const;
+    [[nodiscard]] Iterator end() const;
 
 private:
-    std::vector<ParsedLine> parsed_lines;
-    std::vector<std::shared_ptr<std::string>> name_tags;
+    // Declared first, so that it is released after everything allocated from it.
+    std::pmr::monotonic_buffer_resource arena;
+
+    std::vector<std::uint32_t> line_numbers;
+    std::vector<int> line_addresses;
+    // The instructions can't be moved, so they are built in place, in the arena.
+    std::pmr::deque<Instruction> instructions;
+    std::vector<std::string_view> lines;
+    std::vector<std::uint32_t> name_tag_indices;
+    std::vector<std::uint32_t> context_indices;
+
+    std::optional<LineTokenizer> tokens_of_latest_line;
+
+    // A deque, so that the views of the index stay valid.
+    std::deque<std::string> name_tags;
+    std::unordered_map<std::string_view, std::uint32_t> name_tag_index;
+
+    std::vector<std::shared_ptr<Context>> contexts;
+    std::unordered_map<const Context*, std::uint32_t> context_index;
+
+    // The sources (files or macro expansions) the parsed lines are pointing to.
+    std::vector<std::shared_ptr<const SourceBuffer>> sources;
+
+    void retain_source(const std::shared_ptr<const SourceBuffer>& source);
 
-    std::shared_ptr<std::string> get_name_tag_ref(const std::string& name_tag);
+    std::uint32_t get_name_tag_index(const std::string& name_tag);
+    std::uint32_t get_context_index(const std::shared_ptr<Context>& context);
 };
 
 #endif //INC_8008_ASSEMBLER_PARSED_LINE_STORAGE_H
@@ -0,0 +1,140 @@
+#ifndef INC_8008_ASSEMBLER_PERFECT_HASH_H
+#define INC_8008_ASSEMBLER_PERFECT_HASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+// Case-insensitive lookup of a fixed set of names, in constant time.
+// The table is built at compile time. A multiplier is searched so that the hashes of the
+// names all go to different slots. A lookup then folds the name once, and checks the
+// only name which can match.
+template<std::size_t EntryCount, unsigned SlotBits>
+class PerfectHashTable
+{
+public:
+    static constexpr std::size_t NOT_FOUND = std::numeric_limits<std::size_t>::max();
+
+    // The names are identified by their length and their first characters, folded in a key.
+    static constexpr std::size_t KEY_LENGTH = sizeof(std::uint64_t);
+
+    static constexpr char to_lower(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+    }
+
+    static constexpr std::uint64_t fold_key(std::string_view name)
+    {
+        std::uint64_t key = 0;
+        for (std::size_t index = 0; index < name.size() && index < KEY_LENGTH; index += 1)
+        {
+            key |= static_cast<std::uint64_t>(static_cast<unsigned char>(to_lower(name[index])))
+                   << (8 * index);
+        }
+        return key;
+    }
+
+    constexpr explicit PerfectHashTable(
+            const std::array<std::string_view, EntryCount>& table_names)
+        : names{table_names}
+    {
+        for (std::size_t index = 0; index < EntryCount; index += 1)
+        {
+            keys[index] = fold_key(names[index]);
+        }
+        for (auto& slot : slots)
+        {
+            slot = EMPTY_SLOT;
+        }
+
+        // The multipliers are tried in the same order at each build, so the table is
+        // always the same.
+        std::uint64_t seed = 0x8008'8008'8008'8008;
+        for (int attempt = 0; attempt < MAX_ATTEMPTS && !perfect; attempt += 1)
+        {
+            multiplier = next_random(seed) | 1U;
+            perfect = try_fill_slots();
+        }
+    }
+
+    // False if some names collide, whatever the multiplier, as with duplicated names.
+    [[nodiscard]] constexpr bool is_perfect() const { return perfect; }
+
+    // Returns the index of the name in the names of the table, or NOT_FOUND.
+    [[nodiscard]] constexpr std::size_t find(std::string_view name) const
+    {
+        const auto key = fold_key(name);
+        const auto index = slots[get_slot(key, name.size())];
+        if (index == EMPTY_SLOT || keys[index] != key || names[index].size() != name.size())
+        {
+            return NOT_FOUND;
+        }
+
+        // Only long names need more than their key to be compared.
+        for (std::size_t char_index = KEY_LENGTH; char_index < name.size(); char_index += 1)
+        {
+            if (to_lower(name[char_index]) != to_lower(names[index][char_index]))
+            {
+                return NOT_FOUND;
+            }
+        }
+        return index;
+    }
+
+private:
+    static_assert(SlotBits > 0 && SlotBits < 32);
+
+    static constexpr std::size_t SLOT_COUNT = std::size_t{1} << SlotBits;
+    static constexpr int MAX_ATTEMPTS = 10000;
+
+    using SlotType = std::conditional_t<(EntryCount < 0xff), std::uint8_t, std::uint16_t>;
+    static constexpr SlotType EMPTY_SLOT = std::numeric_limits<SlotType>::max();
+    static_assert(EntryCount < EMPTY_SLOT);
+
+    static constexpr std::uint64_t next_random(std::uint64_t& state)
+    {
+        // SplitMix64
+        state += 0x9e3779b97f4a7c15;
+        auto value = state;
+        value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9;
+        value = (value ^ (value >> 27U)) * 0x94d049bb133111eb;
+        return value ^ (value >> 31U);
+    }
+
+    // The length is added to the key, to separate the long names sharing their first characters.
+    [[nodiscard]] constexpr std::size_t get_slot(std::uint64_t key, std::size_t length) const
+    {
+        return static_cast<std::size_t>(((key + length) * multiplier) >> (64U - SlotBits));
+    }
+
+    constexpr bool try_fill_slots()
+    {
+        for (std::size_t index = 0; index < EntryCount; index += 1)
+        {
+            auto& slot = slots[get_slot(keys[index], names[index].size())];
+            if (slot != EMPTY_SLOT)
+            {
+                // Only the filled slots are emptied for the next attempt.
+                for (std::size_t filled_index = 0; filled_index < index; filled_index += 1)
+                {
+                    slots[get_slot(keys[filled_index], names[filled_index].size())] =
+                            EMPTY_SLOT;
+                }
+                return false;
+            }
+            slot = static_cast<SlotType>(index);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, EntryCount> names{};
+    std::array<std::uint64_t, EntryCount> keys{};
+    std::array<SlotType, SLOT_COUNT> slots{};
+    std::uint64_t multiplier{1};
+    bool perfect{false};
+};
+
+#endif //INC_8008_ASSEMBLER_PERFECT_HASH_H
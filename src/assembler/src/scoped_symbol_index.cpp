@@ -0,0 +1,41 @@
+#include "scoped_symbol_index.h"
+
+#include <cassert>
+
+ScopedSymbolIndex::ScopePath ScopedSymbolIndex::open_scope(const ScopePath& parent_path)
+{
+    ScopePath path;
+    path.reserve(parent_path.size() + 1);
+    path.assign(parent_path.begin(), parent_path.end());
+    path.push_back(scope_count);
+    scope_count += 1;
+    return path;
+}
+
+void ScopedSymbolIndex::define_symbol(const ScopePath& scope_path, SymbolId symbol_id, int value)
+{
+    assert(!scope_path.empty());
+    // A redefinition in the same scope replaces the value.
+    definitions.insert_or_assign(get_definition_key(scope_path.back(), symbol_id), value);
+}
+
+std::tuple<bool, int> ScopedSymbolIndex::get_symbol_value(const ScopePath& scope_path,
+                                                          SymbolId symbol_id) const
+{
+    // The definition from the deepest scope wins.
+    for (auto scope = std::rbegin(scope_path); scope != std::rend(scope_path); ++scope)
+    {
+        const auto found = definitions.find(get_definition_key(*scope, symbol_id));
+        if (found != std::end(definitions))
+        {
+            return {true, found->second};
+        }
+    }
+    return {false, 0};
+}
+
+ScopedSymbolIndex::DefinitionKey ScopedSymbolIndex::get_definition_key(ScopeId scope,
+                                                                       SymbolId symbol_id)
+{
+    return static_cast<DefinitionKey>(scope) << 32 | symbol_id;
+}
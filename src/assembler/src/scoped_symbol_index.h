@@ -0,0 +1,41 @@
+#ifndef INC_8008_ASSEMBLER_SCOPED_SYMBOL_INDEX_H
+#define INC_8008_ASSEMBLER_SCOPED_SYMBOL_INDEX_H
+
+#include "symbol_interner.h"
+
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// The values of the symbols of all the scopes of an assembly, indexed by scope and symbol
+// identifier. A scope sees its own symbols and the ones of its ancestors, the nearest first.
+// The scopes live as long as the lines using them, so they form a tree rather than a stack.
+//
+// A scope is known by its path: the scopes from the root down to itself. Resolving a symbol
+// looks it up in each scope of the path, from the deepest one, so its cost depends on the
+// nesting depth only, whatever the number of scopes defining the same symbol.
+class ScopedSymbolIndex
+{
+public:
+    using ScopeId = std::uint32_t;
+    using ScopePath = std::vector<ScopeId>;
+    using SymbolId = SymbolInterner::SymbolId;
+
+    // The path of a new scope, child of the given path. The root has an empty parent path.
+    ScopePath open_scope(const ScopePath& parent_path);
+
+    void define_symbol(const ScopePath& scope_path, SymbolId symbol_id, int value);
+    [[nodiscard]] std::tuple<bool, int> get_symbol_value(const ScopePath& scope_path,
+                                                         SymbolId symbol_id) const;
+
+private:
+    using DefinitionKey = std::uint64_t;
+
+    [[nodiscard]] static DefinitionKey get_definition_key(ScopeId scope, SymbolId symbol_id);
+
+    std::unordered_map<DefinitionKey, int> definitions;
+    ScopeId scope_count{0};
+};
+
+#endif //INC_8008_ASSEMBLER_SCOPED_SYMBOL_INDEX_H
@@ -9,7 +9,7 @@
 #include <cstdio>
 #include <iostream>
 
-void second_pass(const Options& global_options, std::ostream& output_stream,
+void second_pass(const Options& global_options, ByteWriter& writer,
                  ParsedLineStorage& parsed_line_storage)
 {
     /* Symbols are defined. Second pass. */
@@ -18,10 +18,7 @@ void second_pass(const Options& global_options, std::ostream& output_stream,
         std::cout << "Pass number Two:  Re-read and assemble codes\n";
     }
 
-    ByteWriter writer(output_stream,
-                      global_options.generate_binary_file ? ByteWriter::BINARY : ByteWriter::HEX);
-
-    for (auto& parsed_line : parsed_line_storage)
+    for (const auto parsed_line : parsed_line_storage)
     {
         const auto& input_line = parsed_line.line;
         const auto line_number = parsed_line.line_number;
@@ -31,16 +28,16 @@ void second_pass(const Options& global_options, std::ostream& output_stream,
         {
             if (global_options.verbose || global_options.debug)
             {
-                printf("     0x%X \"%s\"\n", line_address, input_line.c_str());
+                printf("     0x%X \"%.*s\"\n", line_address, static_cast<int>(input_line.size()),
+                       input_line.data());
             }
 
             const auto& instruction = parsed_line.instruction;
-            const auto& associated_context = parsed_line.context;
-            instruction.second_pass(*associated_context, writer, line_address);
+            instruction.second_pass(parsed_line.context, writer, line_address);
         }
         catch (const std::exception& ex)
         {
-            throw ParsingException(ex, line_number, *parsed_line.name_tag, input_line);
+            throw ParsingException(ex, line_number, parsed_line.name_tag, input_line);
         }
     }
     writer.write_end();
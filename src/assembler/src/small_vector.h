@@ -0,0 +1,117 @@
+#ifndef INC_8008_ASSEMBLER_SMALL_VECTOR_H
+#define INC_8008_ASSEMBLER_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// A vector holding its first elements inline, without allocation. When it grows past the
+// inline capacity, all the elements move to the heap.
+template<typename T, std::size_t InlineCapacity>
+class SmallVector
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+    SmallVector(std::initializer_list<T> values)
+    {
+        for (const auto& value : values)
+        {
+            push_back(value);
+        }
+    }
+
+    SmallVector(const SmallVector&) = default;
+    SmallVector& operator=(const SmallVector&) = default;
+
+    SmallVector(SmallVector&& other) noexcept
+        : inline_items{std::move(other.inline_items)}, heap_items{std::move(other.heap_items)},
+          item_count{std::exchange(other.item_count, 0)}
+    {
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept
+    {
+        inline_items = std::move(other.inline_items);
+        heap_items = std::move(other.heap_items);
+        item_count = std::exchange(other.item_count, 0);
+        return *this;
+    }
+
+    void push_back(T value)
+    {
+        if (item_count < InlineCapacity)
+        {
+            inline_items[item_count] = std::move(value);
+        }
+        else
+        {
+            if (item_count == InlineCapacity)
+            {
+                heap_items.reserve(InlineCapacity * 2);
+                heap_items.assign(std::make_move_iterator(std::begin(inline_items)),
+                                  std::make_move_iterator(std::end(inline_items)));
+            }
+            heap_items.push_back(std::move(value));
+        }
+        item_count += 1;
+    }
+
+    void pop_back()
+    {
+        item_count -= 1;
+        if (item_count > InlineCapacity)
+        {
+            heap_items.pop_back();
+        }
+        else if (item_count == InlineCapacity)
+        {
+            // The heap keeps its capacity, so growing again doesn't allocate.
+            std::move(std::begin(heap_items), std::begin(heap_items) + InlineCapacity,
+                      std::begin(inline_items));
+            heap_items.clear();
+        }
+        else
+        {
+            inline_items[item_count] = T{};
+        }
+    }
+
+    [[nodiscard]] size_type size() const { return item_count; }
+    [[nodiscard]] bool empty() const { return item_count == 0; }
+
+    T* data() { return is_inline() ? inline_items.data() : heap_items.data(); }
+    const T* data() const { return is_inline() ? inline_items.data() : heap_items.data(); }
+
+    T& operator[](size_type index) { return data()[index]; }
+    const T& operator[](size_type index) const { return data()[index]; }
+
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+    T& back() { return data()[item_count - 1]; }
+    const T& back() const { return data()[item_count - 1]; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + item_count; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + item_count; }
+
+private:
+    [[nodiscard]] bool is_inline() const { return item_count <= InlineCapacity; }
+
+    std::array<T, InlineCapacity> inline_items{};
+    std::vector<T> heap_items;
+    size_type item_count{0};
+};
+
+#endif //INC_8008_ASSEMBLER_SMALL_VECTOR_H
@@ -0,0 +1,114 @@
+#include "symbol_interner.h"
+
+#include <cassert>
+
+namespace
+{
+    constexpr char fold(char c) { return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 32) : c; }
+
+    // FNV-1a on the folded characters, so that the name doesn't need to be folded in a copy.
+    std::uint32_t hash_folded(std::string_view name)
+    {
+        std::uint32_t hash = 2166136261U;
+        for (const char c : name)
+        {
+            hash ^= static_cast<unsigned char>(fold(c));
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+    bool equals_folded(std::string_view name, const std::string& folded_name)
+    {
+        if (name.size() != folded_name.size())
+        {
+            return false;
+        }
+        for (std::size_t index = 0; index < name.size(); index += 1)
+        {
+            if (fold(name[index]) != folded_name[index])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+SymbolInterner::SymbolId SymbolInterner::intern(std::string_view name)
+{
+    // The table is kept at most half full.
+    if ((folded_names.size() + 1) * 2 > slots.size())
+    {
+        grow();
+    }
+
+    const auto hash = hash_folded(name);
+    auto& slot = slots[find_slot(name, hash)];
+    if (slot.id != NO_SYMBOL)
+    {
+        return slot.id;
+    }
+
+    std::string folded_name{name};
+    for (auto& c : folded_name)
+    {
+        c = fold(c);
+    }
+    folded_names.push_back(std::move(folded_name));
+
+    slot = {hash, static_cast<SymbolId>(folded_names.size() - 1)};
+    return slot.id;
+}
+
+SymbolInterner::SymbolId SymbolInterner::find(std::string_view name) const
+{
+    if (slots.empty())
+    {
+        return NO_SYMBOL;
+    }
+    return slots[find_slot(name, hash_folded(name))].id;
+}
+
+const std::string& SymbolInterner::get_name(SymbolId id) const
+{
+    assert(id < folded_names.size());
+    return folded_names[id];
+}
+
+std::size_t SymbolInterner::size() const { return folded_names.size(); }
+
+std::size_t SymbolInterner::find_slot(std::string_view name, std::uint32_t hash) const
+{
+    // Either the slot of the name, or the empty slot where it would go.
+    const auto mask = slots.size() - 1;
+    auto index = hash & mask;
+    while (slots[index].id != NO_SYMBOL &&
+           (slots[index].hash != hash || !equals_folded(name, folded_names[slots[index].id])))
+    {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+void SymbolInterner::grow()
+{
+    const auto new_size = slots.empty() ? std::size_t{64} : slots.size() * 2;
+    std::vector<Slot> previous_slots(new_size);
+    std::swap(slots, previous_slots);
+
+    const auto mask = slots.size() - 1;
+    for (const auto& slot : previous_slots)
+    {
+        if (slot.id == NO_SYMBOL)
+        {
+            continue;
+        }
+        auto index = slot.hash & mask;
+        while (slots[index].id != NO_SYMBOL)
+        {
+            index = (index + 1) & mask;
+        }
+        slots[index] = slot;
+    }
+}
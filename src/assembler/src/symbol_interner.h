@@ -0,0 +1,46 @@
+#ifndef INC_8008_ASSEMBLER_SYMBOL_INTERNER_H
+#define INC_8008_ASSEMBLER_SYMBOL_INTERNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Gives a dense identifier to each symbol name. Names are case-insensitive: they are folded
+// once, when they are interned, and the same identifier is given to all their casings.
+class SymbolInterner
+{
+public:
+    using SymbolId = std::uint32_t;
+    static constexpr SymbolId NO_SYMBOL = std::numeric_limits<SymbolId>::max();
+
+    // Returns the identifier of the name, giving it the next identifier if it is new.
+    SymbolId intern(std::string_view name);
+
+    // Returns the identifier of the name, or NO_SYMBOL if it was never interned.
+    [[nodiscard]] SymbolId find(std::string_view name) const;
+
+    // The folded name of an identifier.
+    [[nodiscard]] const std::string& get_name(SymbolId id) const;
+
+    // The identifiers go from 0 to size() - 1.
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    // An open-addressing table, with linear probing, of the indexes of the names.
+    struct Slot
+    {
+        std::uint32_t hash{0};
+        SymbolId id{NO_SYMBOL};
+    };
+
+    [[nodiscard]] std::size_t find_slot(std::string_view name, std::uint32_t hash) const;
+    void grow();
+
+    std::vector<std::string> folded_names;
+    std::vector<Slot> slots;
+};
+
+#endif //INC_8008_ASSEMBLER_SYMBOL_INTERNER_H
@@ -1,45 +1,82 @@
 #include "symbol_table.h"
 
-#include <algorithm>
+#include <cassert>
 #include <iomanip>
 #include <iostream>
 
+SymbolTable::SymbolTable() : SymbolTable{std::make_shared<SymbolInterner>()} {}
+
+SymbolTable::SymbolTable(std::shared_ptr<SymbolInterner> interner, Storage storage)
+    : interner{std::move(interner)}, storage{storage}
+{
+    assert(this->interner != nullptr);
+}
+
 void SymbolTable::define_symbol(const std::string_view symbol_name, int value)
 {
-    std::string upper{symbol_name};
-    transform(upper.begin(), upper.end(), upper.begin(), toupper);
+    define_symbol(interner->intern(symbol_name), symbol_name, value);
+}
+
+std::tuple<bool, int> SymbolTable::get_symbol_value(const std::string_view symbol_name) const
+{
+    return get_symbol_value(interner->find(symbol_name));
+}
+
+void SymbolTable::define_symbol(SymbolId symbol_id, std::string_view symbol_name, int value)
+{
+    assert(symbol_id < interner->size());
+    if (storage == Storage::SPARSE)
+    {
+        const auto [position, inserted] = sparse_values.insert_or_assign(symbol_id, value);
+        defined_count += inserted ? 1 : 0;
+    }
+    else
+    {
+        if (symbol_id >= values.size())
+        {
+            values.resize(symbol_id + 1);
+            defined.resize(symbol_id + 1);
+        }
 
-    // Symbols keys are upper string labels
-    symbols[upper] = value;
+        values[symbol_id] = value;
+        if (!defined[symbol_id])
+        {
+            defined[symbol_id] = true;
+            defined_count += 1;
+        }
+    }
 
     // The insertion order also keeps the original casing.
-    insertion_order.emplace_back(symbol_name);
+    insertion_order.push_back({symbol_id, std::string{symbol_name}});
 }
 
-std::tuple<bool, int> SymbolTable::get_symbol_value(const std::string_view symbol_name) const
+std::tuple<bool, int> SymbolTable::get_symbol_value(SymbolId symbol_id) const
 {
-    std::string upper{symbol_name};
-    transform(upper.begin(), upper.end(), upper.begin(), toupper);
-
-    auto it = symbols.find(std::string{upper});
-    if (it != symbols.end())
+    if (const auto* value = find_value(symbol_id); value != nullptr)
     {
-        return {true, it->second};
+        return {true, *value};
     }
     return {false, 0};
 }
 
+const int* SymbolTable::find_value(SymbolId symbol_id) const
+{
+    if (storage == Storage::SPARSE)
+    {
+        const auto found = sparse_values.find(symbol_id);
+        return found != std::end(sparse_values) ? &found->second : nullptr;
+    }
+    return symbol_id < values.size() && defined[symbol_id] ? &values[symbol_id] : nullptr;
+}
+
 void SymbolTable::list_symbols(std::ostream& output)
 {
-    output << "Symbol Count: " << symbols.size() << "\n";
+    output << "Symbol Count: " << defined_count << "\n";
     output << "    Symbol  Oct Val  DecVal\n";
     output << "    ------  -------  ------\n";
-    for (auto& sorted_label : insertion_order)
+    for (const auto& [id, sorted_label] : insertion_order)
     {
-        std::string upper{sorted_label};
-        transform(upper.begin(), upper.end(), upper.begin(), toupper);
-
-        auto value = std::get<1>(*symbols.find(upper));
+        const auto value = *find_value(id);
         if (value > 255)
         {
             const auto high = (value >> 8) & 0xFF;
@@ -59,3 +96,25 @@ void SymbolTable::list_symbols(std::ostream& output)
         }
     }
 }
+
+std::vector<SymbolTable::Symbol> SymbolTable::get_symbols() const
+{
+    std::vector<Symbol> result;
+    result.reserve(insertion_order.size());
+    for (const auto& [id, name] : insertion_order)
+    {
+        result.push_back({name, *find_value(id)});
+    }
+    return result;
+}
+
+const std::shared_ptr<SymbolInterner>& SymbolTable::get_interner() const { return interner; }
+
+std::size_t SymbolTable::get_memory_usage() const
+{
+    // The nodes of the map hold a pointer to the next node, besides the pair.
+    const auto sparse_bytes =
+            sparse_values.size() * (sizeof(void*) + sizeof(std::pair<const SymbolId, int>)) +
+            sparse_values.bucket_count() * sizeof(void*);
+    return values.capacity() * sizeof(int) + defined.capacity() / 8 + sparse_bytes;
+}
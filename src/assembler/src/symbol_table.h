@@ -1,20 +1,77 @@
 #ifndef INC_8008_ASSEMBLER_SYMBOL_TABLE_H
 #define INC_8008_ASSEMBLER_SYMBOL_TABLE_H
 
+#include "symbol_interner.h"
+
+#include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 class SymbolTable
 {
 public:
+    using SymbolId = SymbolInterner::SymbolId;
+
+    struct Symbol
+    {
+        std::string name;
+        int value;
+    };
+
+    // A dense table is indexed by the identifiers, and so takes room for all the symbols of
+    // the interner. A sparse table only takes room for its own symbols.
+    enum class Storage
+    {
+        DENSE,
+        SPARSE,
+    };
+
+    SymbolTable();
+    // Tables sharing an interner give the same identifiers to the same names.
+    explicit SymbolTable(std::shared_ptr<SymbolInterner> interner,
+                         Storage storage = Storage::DENSE);
+
     void define_symbol(std::string_view symbol_name, int value);
     std::tuple<bool, int> get_symbol_value(std::string_view symbol_name) const;
+
+    // The same, with the identifier given by the interner of the table.
+    void define_symbol(SymbolId symbol_id, std::string_view symbol_name, int value);
+    [[nodiscard]] std::tuple<bool, int> get_symbol_value(SymbolId symbol_id) const;
+
     void list_symbols(std::ostream& output);
 
+    // The symbols in their definition order, with their original casing.
+    [[nodiscard]] std::vector<Symbol> get_symbols() const;
+
+    [[nodiscard]] const std::shared_ptr<SymbolInterner>& get_interner() const;
+
+    // The bytes held for the values, without the names.
+    [[nodiscard]] std::size_t get_memory_usage() const;
+
 private:
-    std::unordered_map<std::string, int> symbols;
-    std::vector<std::string> insertion_order;
+    struct Definition
+    {
+        SymbolId id;
+        std::string name;
+    };
+
+    [[nodiscard]] const int* find_value(SymbolId symbol_id) const;
+
+    std::shared_ptr<SymbolInterner> interner;
+    Storage storage;
+
+    // Indexed by the symbol identifiers, for a dense table.
+    std::vector<int> values;
+    std::vector<bool> defined;
+    // For a sparse table.
+    std::unordered_map<SymbolId, int> sparse_values;
+    std::size_t defined_count{0};
+
+    std::vector<Definition> insertion_order;
 };
 
 #endif //INC_8008_ASSEMBLER_SYMBOL_TABLE_H
@@ -0,0 +1,123 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace
+{
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> task_indices;
+
+        std::optional<std::size_t> pop_front()
+        {
+            std::lock_guard lock{mutex};
+            if (task_indices.empty())
+            {
+                return {};
+            }
+            const auto index = task_indices.front();
+            task_indices.pop_front();
+            return index;
+        }
+
+        std::optional<std::size_t> steal_back()
+        {
+            std::lock_guard lock{mutex};
+            if (task_indices.empty())
+            {
+                return {};
+            }
+            const auto index = task_indices.back();
+            task_indices.pop_back();
+            return index;
+        }
+    };
+
+    void run_task(const ThreadPool::Task& task, std::exception_ptr& exception)
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+    }
+}
+
+ThreadPool::ThreadPool(std::size_t thread_count) : thread_count{thread_count}
+{
+    if (this->thread_count == 0)
+    {
+        this->thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+}
+
+std::size_t ThreadPool::get_thread_count() const { return thread_count; }
+
+void ThreadPool::run(const std::vector<Task>& tasks) const
+{
+    std::vector<std::exception_ptr> exceptions(tasks.size());
+    const auto worker_count = std::min(thread_count, tasks.size());
+
+    if (worker_count <= 1)
+    {
+        for (std::size_t index = 0; index < tasks.size(); index += 1)
+        {
+            run_task(tasks[index], exceptions[index]);
+        }
+    }
+    else
+    {
+        // Tasks are spread in contiguous ranges, so that a worker runs them in order.
+        std::vector<WorkQueue> queues(worker_count);
+        for (std::size_t index = 0; index < tasks.size(); index += 1)
+        {
+            queues[index * worker_count / tasks.size()].task_indices.push_back(index);
+        }
+
+        auto worker = [&tasks, &exceptions, &queues](std::size_t worker_index) {
+            const auto queue_count = queues.size();
+            for (;;)
+            {
+                auto task_index = queues[worker_index].pop_front();
+                for (std::size_t offset = 1; !task_index && offset < queue_count; offset += 1)
+                {
+                    task_index = queues[(worker_index + offset) % queue_count].steal_back();
+                }
+                if (!task_index)
+                {
+                    // Tasks don't create other tasks, so all the queues stay empty.
+                    return;
+                }
+                run_task(tasks[*task_index], exceptions[*task_index]);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(worker_count - 1);
+        for (std::size_t worker_index = 1; worker_index < worker_count; worker_index += 1)
+        {
+            threads.emplace_back(worker, worker_index);
+        }
+        worker(0);
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    auto first_exception = std::ranges::find_if(exceptions, [](auto& e) { return e != nullptr; });
+    if (first_exception != std::end(exceptions))
+    {
+        std::rethrow_exception(*first_exception);
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef INC_8008_ASSEMBLER_THREAD_POOL_H
+#define INC_8008_ASSEMBLER_THREAD_POOL_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Runs independent tasks on a set of worker threads.
+// The tasks are spread on the workers, each with its own queue. A worker with an empty
+// queue steals tasks from the end of the other queues, so long tasks don't leave
+// workers idle.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // With a thread count of zero, the number of hardware threads is used.
+    explicit ThreadPool(std::size_t thread_count);
+
+    [[nodiscard]] std::size_t get_thread_count() const;
+
+    // Runs all the tasks and returns when they are all finished.
+    // If tasks throw, the exception of the first of these tasks, in the order of the
+    // tasks, is thrown again. With only one thread, the tasks are run in order on the
+    // calling thread.
+    void run(const std::vector<Task>& tasks) const;
+
+private:
+    std::size_t thread_count;
+};
+
+#endif //INC_8008_ASSEMBLER_THREAD_POOL_H
@@ -1,12 +1,16 @@
 #include "utils.h"
 
-#include <cstring>
 #include <cctype>
 #include <algorithm>
 
 bool ci_equals(const std::string_view& lhs, const std::string_view& rhs)
 {
-    return strcasecmp(lhs.data(), rhs.data()) == 0;
+    // Views are not null terminated, so they are compared on their length.
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) ==
+                      std::tolower(static_cast<unsigned char>(b));
+           });
 }
 
 std::string_view left_trim_string(std::string_view str)
@@ -0,0 +1,142 @@
+#include "assemble.h"
+
+#include "errors.h"
+#include "files/files.h"
+#include "options.h"
+
+#include "gmock/gmock.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+using namespace testing;
+
+TEST(Assemble, assembles_a_source_in_memory)
+{
+    Options options;
+    const auto result = assemble(options, "source.asm", "        ORG 100\n"
+                                                        "start:  LAI 1\n"
+                                                        "        JMP start\n");
+
+    ASSERT_THAT(result.memory, SizeIs(16 * 1024));
+    ASSERT_THAT(std::vector<std::uint8_t>(result.memory.begin() + 100, result.memory.begin() + 105),
+                ElementsAre(0006, 1, 0104, 100, 0));
+    ASSERT_THAT(result.output, Eq(":050064000601446400E8\n:00000001FF\n"));
+    ASSERT_THAT(result.listing, HasSubstr("Infile=source.asm"));
+    ASSERT_THAT(result.symbols, SizeIs(1));
+    ASSERT_THAT(result.symbols[0].name, Eq("start"));
+    ASSERT_THAT(result.symbols[0].value, Eq(100));
+}
+
+TEST(Assemble, writes_binary_output)
+{
+    Options options;
+    options.generate_binary_file = true;
+    options.generate_list_file = false;
+
+    const auto result = assemble(options, "source.asm", "        LAA\n");
+
+    ASSERT_THAT(result.output, SizeIs(16 * 1024));
+    ASSERT_THAT(static_cast<unsigned char>(result.output[0]), Eq(0300));
+    ASSERT_THAT(result.listing, IsEmpty());
+}
+
+TEST(Assemble, writes_the_same_output_and_listing_in_verbose_mode)
+{
+    constexpr std::string_view source = "        ORG 10\n"
+                                        "start:  LAI H(start)\n"
+                                        "        DATA 1, 2, 3\n"
+                                        "        JMP start\n";
+    Options options;
+    const auto result = assemble(options, "source.asm", source);
+
+    options.verbose = true;
+    std::stringstream traces;
+    auto* const previous_buffer = std::cout.rdbuf(traces.rdbuf());
+    const auto verbose_result = assemble(options, "source.asm", source);
+    std::cout.rdbuf(previous_buffer);
+
+    ASSERT_THAT(verbose_result.output, Eq(result.output));
+    ASSERT_THAT(verbose_result.listing, Eq(result.listing));
+}
+
+namespace
+{
+    // Enough lines to be built by several tasks, with an undefined symbol in the failing line.
+    std::string make_long_source(std::size_t line_count, std::size_t failing_line = 0)
+    {
+        std::string source;
+        for (std::size_t line = 1; line <= line_count; line += 1)
+        {
+            if (line == failing_line)
+            {
+                source += "        LAI XX\n";
+            }
+            else if (line % 2 == 1)
+            {
+                source += "        LAI " + std::to_string(line % 256) + "\n";
+            }
+            else
+            {
+                source += "; comment\n";
+            }
+        }
+        return source;
+    }
+}
+
+TEST(Assemble, writes_the_same_output_with_any_thread_count)
+{
+    const auto source = make_long_source(10000);
+    Options options;
+    options.thread_count = 1;
+    const auto result = assemble(options, "source.asm", source);
+
+    options.thread_count = 4;
+    const auto parallel_result = assemble(options, "source.asm", source);
+
+    ASSERT_THAT(parallel_result.output, Eq(result.output));
+    ASSERT_THAT(parallel_result.listing, Eq(result.listing));
+}
+
+TEST(Assemble, reports_the_first_failing_line_with_several_threads)
+{
+    auto source = make_long_source(10000, 9001);
+    source += "        LAI UNKNOWN\n";
+
+    Options options;
+    options.thread_count = 4;
+    try
+    {
+        std::ignore = assemble(options, "source.asm", source);
+        FAIL();
+    }
+    catch (const ParsingException& ex)
+    {
+        ASSERT_THAT(ex.what(),
+                    StrEq("cannot find symbol XX in line source.asm::9001:         LAI XX"));
+    }
+}
+
+TEST(Assemble, includes_in_memory_files)
+{
+    Options options;
+    const InMemoryFiles files{{"values.inc", "VALUE:  EQU 42\n"}};
+
+    const auto result = assemble(options, "source.asm",
+                                 "        .include values.inc\n"
+                                 "        LAI VALUE\n",
+                                 files);
+
+    ASSERT_THAT(result.memory[0], Eq(0006));
+    ASSERT_THAT(result.memory[1], Eq(42));
+}
+
+TEST(Assemble, cannot_include_a_missing_in_memory_file)
+{
+    Options options;
+
+    ASSERT_THROW(assemble(options, "source.asm", "        .include values.inc\n"), CannotOpenFile);
+}
@@ -0,0 +1,87 @@
+#include "character_classifier.h"
+
+#include "gmock/gmock.h"
+
+#include <random>
+#include <string>
+
+using namespace testing;
+
+TEST(ClassifiedBlock, gives_the_positions_of_each_class)
+{
+    std::string text = "a b,c;d'e\"f\tg";
+    text.resize(ClassifiedBlock::SIZE, 'x');
+
+    ClassifiedBlock block;
+    classify_block(text.data(), block);
+
+    ASSERT_THAT(block.get_mask(CharacterClasses::BLANK), Eq((1U << 1U) | (1U << 11U)));
+    ASSERT_THAT(block.get_mask(CharacterClasses::COMMA), Eq(1U << 3U));
+    ASSERT_THAT(block.get_mask(CharacterClasses::SEMICOLON), Eq(1U << 5U));
+    ASSERT_THAT(block.get_mask(CharacterClasses::QUOTE), Eq((1U << 7U) | (1U << 9U)));
+    ASSERT_THAT(block.get_mask(CharacterClasses::COMMA | CharacterClasses::SEMICOLON),
+                Eq((1U << 3U) | (1U << 5U)));
+}
+
+TEST(ClassifiedBlock, is_the_same_with_all_the_available_kernels)
+{
+    std::mt19937 generator{8008};
+    std::uniform_int_distribution<int> characters{0, 255};
+
+    for (int iteration = 0; iteration < 100; iteration += 1)
+    {
+        std::string text;
+        for (std::size_t index = 0; index < ClassifiedBlock::SIZE; index += 1)
+        {
+            // Some characters of the classes are forced, as they are rare at random.
+            const auto character = characters(generator);
+            text += character < 64 ? " \t,;'\""[character % 6] : static_cast<char>(character);
+        }
+
+        ClassifiedBlock expected;
+        classify_block(ClassificationKernel::SCALAR, text.data(), expected);
+
+        for (const auto kernel : get_available_classification_kernels())
+        {
+            ClassifiedBlock block;
+            classify_block(kernel, text.data(), block);
+            ASSERT_THAT(block.masks, Eq(expected.masks));
+        }
+    }
+}
+
+TEST(CharacterClassifier, finds_the_first_character_of_the_classes)
+{
+    CharacterClassifier classifier{"LAI 1,2 ; comment"};
+
+    ASSERT_THAT(classifier.find_first_of(0, CharacterClasses::BLANK), Eq(3));
+    ASSERT_THAT(classifier.find_first_of(4, CharacterClasses::COMMA), Eq(5));
+    ASSERT_THAT(classifier.find_first_of(6, CharacterClasses::SEMICOLON), Eq(8));
+    ASSERT_THAT(classifier.find_first_of(9, CharacterClasses::COMMA), Eq(std::string_view::npos));
+}
+
+TEST(CharacterClassifier, finds_the_first_character_out_of_the_classes)
+{
+    CharacterClassifier classifier{"  \t LAA \t "};
+
+    ASSERT_THAT(classifier.find_first_not_of(0, CharacterClasses::BLANK), Eq(4));
+    ASSERT_THAT(classifier.find_first_not_of(7, CharacterClasses::BLANK),
+                Eq(std::string_view::npos));
+}
+
+TEST(CharacterClassifier, searches_past_the_first_blocks)
+{
+    std::string text(3 * ClassifiedBlock::SIZE + 10, ' ');
+    text[2 * ClassifiedBlock::SIZE + 5] = ';';
+    text.back() = 'x';
+
+    CharacterClassifier classifier{text};
+
+    ASSERT_THAT(classifier.find_first_of(0, CharacterClasses::SEMICOLON),
+                Eq(2 * ClassifiedBlock::SIZE + 5));
+    ASSERT_THAT(classifier.find_first_not_of(0, CharacterClasses::BLANK),
+                Eq(2 * ClassifiedBlock::SIZE + 5));
+    ASSERT_THAT(classifier.find_first_not_of(2 * ClassifiedBlock::SIZE + 6,
+                                             CharacterClasses::BLANK),
+                Eq(text.size() - 1));
+}
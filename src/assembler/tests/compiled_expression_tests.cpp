@@ -0,0 +1,112 @@
+#include "evaluation/compiled_expression.h"
+
+#include "context.h"
+#include "evaluation/evaluate.h"
+#include "evaluation/evaluator.h"
+#include "options.h"
+
+#include "gmock/gmock.h"
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+using namespace testing;
+
+struct CompiledExpressionFixture : public Test
+{
+    CompiledExpressionFixture()
+    {
+        context.define_symbol("START", 0x1234);
+        context.define_symbol("value", 42);
+        context.define_symbol("label_", 7);
+    }
+
+    Options options;
+    Context context{options};
+};
+
+TEST_F(CompiledExpressionFixture, evaluates_as_the_evaluator)
+{
+    for (const auto* expression :
+         {"1234", "  12 ", "0x10+2", "2-4+10*2", "100o*2", "0FFh/3", "(1+2)*3", "-1", "+5",
+          "2*-3", "-(2+3)*2", "START", "start+2", "H(START)", "L(START)", "\\HB\\START",
+          "\\LB\\START", "H(L(START))", "'A'+0x80", "' '", "square(3)+1", "unknown(3)",
+          "square(value-40)", "3 4!", "value 1!", "3#4", "label_0 ", "(((1)))", "10/3"})
+    {
+        const CompiledExpression compiled{context, expression};
+
+        ASSERT_THAT(compiled.is_compiled(), IsTrue()) << expression;
+        ASSERT_THAT(compiled.evaluate(context), Eq(evaluate_argument(context, expression)))
+                << expression;
+    }
+}
+
+TEST_F(CompiledExpressionFixture, resolves_symbols_defined_after_the_compilation)
+{
+    const CompiledExpression compiled{context, "LATER*2"};
+    ASSERT_THROW(compiled.evaluate(context), CannotFindSymbol);
+
+    context.define_symbol("later", 21);
+    ASSERT_THAT(compiled.evaluate(context), Eq(42));
+}
+
+TEST_F(CompiledExpressionFixture, raises_the_errors_of_the_evaluator_when_evaluated)
+{
+    const CompiledExpression undefined{context, "undefined/0"};
+    const CompiledExpression division_by_zero{context, "10/(value-42)"};
+
+    ASSERT_THROW(undefined.evaluate(context), CannotFindSymbol);
+    ASSERT_THROW(division_by_zero.evaluate(context), IllFormedExpression);
+}
+
+TEST_F(CompiledExpressionFixture, keeps_as_text_what_the_evaluator_can_not_run)
+{
+    for (const auto* expression : {"1+2)", "79o", "+", "2*", "(1", "'A", "value!"})
+    {
+        const CompiledExpression compiled{context, expression};
+        ASSERT_THAT(compiled.is_compiled(), IsFalse()) << expression;
+        ASSERT_ANY_THROW(compiled.evaluate(context)) << expression;
+    }
+
+    const CompiledExpression invalid_number{context, "START+1012b"};
+    ASSERT_THROW(invalid_number.evaluate(context), InvalidNumber);
+}
+
+TEST_F(CompiledExpressionFixture, keeps_as_text_for_the_legacy_evaluator)
+{
+    context.get_options().legacy_evaluator = true;
+    const CompiledExpression compiled{context, "START+2"};
+
+    ASSERT_THAT(compiled.is_compiled(), IsFalse());
+    ASSERT_THAT(compiled.evaluate(context), Eq(0x1236));
+}
+
+TEST_F(CompiledExpressionFixture, can_be_evaluated_in_a_context_with_another_interner)
+{
+    const CompiledExpression compiled{context, "VALUE+1"};
+
+    Context other_context{options};
+    other_context.define_symbol("other", 1);
+    other_context.define_symbol("value", 10);
+
+    ASSERT_THAT(compiled.evaluate(other_context), Eq(11));
+}
+
+TEST_F(CompiledExpressionFixture, prints_the_same_debug_output_as_the_evaluator)
+{
+    context.get_options().debug = true;
+    const CompiledExpression compiled{context, "H(START+1)"};
+
+    std::stringstream compiled_output;
+    auto* const previous_buffer = std::cout.rdbuf(compiled_output.rdbuf());
+    const auto compiled_value = compiled.evaluate(context);
+
+    std::stringstream evaluator_output;
+    std::cout.rdbuf(evaluator_output.rdbuf());
+    const auto evaluator_value = evaluate_argument(context, "H(START+1)");
+    std::cout.rdbuf(previous_buffer);
+
+    ASSERT_THAT(compiled_value, Eq(evaluator_value));
+    ASSERT_THAT(compiled_output.str(), Eq(evaluator_output.str()));
+}
@@ -1,8 +1,11 @@
 #include "context.h"
 
+#include "files/file_reader.h"
+#include "macro_content.h"
 #include "options.h"
 
 #include <memory>
+#include <string>
 
 #include "gmock/gmock.h"
 
@@ -68,6 +71,48 @@ TEST(Context, context_can_be_copy_constructed_and_has_local_symbol_definitions)
     ASSERT_THAT(failure, IsFalse());
 }
 
+TEST(Context, local_symbols_shadow_the_parent_ones_and_are_not_seen_by_siblings)
+{
+    Options options;
+    auto parent = std::make_shared<Context>(options);
+    auto child = std::make_shared<Context>(parent);
+    auto sibling = std::make_shared<Context>(parent);
+    Context grandchild(child);
+
+    child->define_symbol("local", 1);
+    parent->define_symbol("LOCAL", 2);
+
+    ASSERT_THAT(grandchild.get_symbol_value("Local"), Eq(std::make_tuple(true, 1)));
+    ASSERT_THAT(child->get_symbol_value("local"), Eq(std::make_tuple(true, 1)));
+    ASSERT_THAT(sibling->get_symbol_value("local"), Eq(std::make_tuple(true, 2)));
+    ASSERT_THAT(parent->get_symbol_value("local"), Eq(std::make_tuple(true, 2)));
+}
+
+TEST(Context, symbols_of_macro_calls_take_room_only_for_themselves)
+{
+    Options options;
+    auto parent = std::make_shared<Context>(options);
+    for (int index = 0; index < 10000; index += 1)
+    {
+        parent->define_symbol("symbol_" + std::to_string(index), index);
+    }
+
+    MacroContent macro{"a_macro_name", {}};
+    macro.append_line("local EQU 1");
+    FileReader file_reader;
+
+    for (int call = 0; call < 100; call += 1)
+    {
+        Context call_context(parent);
+        call_context.call_macro(&macro, {}, file_reader, [] {});
+        call_context.define_symbol("local", call);
+
+        ASSERT_THAT(call_context.get_symbol_value("local"), Eq(std::make_tuple(true, call)));
+        ASSERT_THAT(call_context.get_symbol_table().get_memory_usage(), Lt(1024));
+    }
+    ASSERT_THAT(parent->get_symbol_table().get_memory_usage(), Ge(10000 * sizeof(int)));
+}
+
 TEST(Context, can_check_if_it_has_a_macro_by_name)
 {
     Options options;
@@ -106,3 +151,59 @@ TEST(Context, cannot_declare_twice_a_macro_with_the_same_name)
         ASSERT_THROW(ctx_2.start_macro("a_macro_name", {}), AlreadyDefinedMacro);
     }
 }
+
+TEST(Context, substitutes_nothing_outside_of_a_macro_call)
+{
+    Options options;
+    Context ctx(options);
+
+    LineTokenizer::Arguments arguments{"param"};
+    ctx.substitute_macro_arguments(nullptr, arguments);
+
+    ASSERT_THAT(arguments, ElementsAre("param"));
+}
+
+TEST(Context, substitutes_the_arguments_of_a_macro_call)
+{
+    Options options;
+    auto ctx_1 = std::make_shared<Context>(options);
+    Context ctx_2(ctx_1);
+
+    MacroContent macro{"a_macro_name", {"first", "second"}};
+    macro.append_line("    DATA second,first,third");
+
+    FileReader file_reader;
+    ctx_2.call_macro(&macro, {"1", "2"}, file_reader, [] {});
+
+    const auto* line_template = ctx_2.get_macro_line_template(macro.get_body(), 1);
+    ASSERT_THAT(line_template, NotNull());
+
+    auto template_arguments = line_template->tokens.arguments;
+    ctx_2.substitute_macro_arguments(line_template, template_arguments);
+    ASSERT_THAT(template_arguments, ElementsAre("2", "1", "third"));
+
+    LineTokenizer::Arguments included_arguments{"FIRST", "other"};
+    ctx_2.substitute_macro_arguments(nullptr, included_arguments);
+    ASSERT_THAT(included_arguments, ElementsAre("1", "other"));
+}
+
+TEST(Context, does_not_substitute_in_contexts_opened_during_a_macro_call)
+{
+    Options options;
+    auto ctx_1 = std::make_shared<Context>(options);
+    auto ctx_2 = std::make_shared<Context>(ctx_1);
+
+    MacroContent macro{"a_macro_name", {"first"}};
+    macro.append_line("    LAI first");
+
+    FileReader file_reader;
+    ctx_2->call_macro(&macro, {"1"}, file_reader, [] {});
+    Context ctx_3(ctx_2);
+
+    const auto* line_template = ctx_3.get_macro_line_template(macro.get_body(), 1);
+    ASSERT_THAT(line_template, NotNull());
+
+    auto arguments = line_template->tokens.arguments;
+    ctx_3.substitute_macro_arguments(line_template, arguments);
+    ASSERT_THAT(arguments, ElementsAre("first"));
+}
@@ -14,8 +14,8 @@ struct DataExtractorFixture : public Test
 
 TEST_F(DataExtractorFixture, evaluates_int)
 {
-    std::vector<int> out_data;
-    std::vector<std::string> tokens = {"100"};
+    std::pmr::vector<int> out_data;
+    std::vector<std::string_view> tokens = {"100"};
     auto number = decode_data(context, tokens, out_data);
 
     ASSERT_THAT(number, Eq(1));
@@ -25,16 +25,16 @@ TEST_F(DataExtractorFixture, evaluates_int)
 TEST_F(DataExtractorFixture, throws_if_too_much_data)
 {
     context.get_options().data_per_line_limit = 12;
-    std::vector<int> out_data;
-    std::vector<std::string> tokens = {"1", "2", "3",  "4",  "5",  "6", "7",
+    std::pmr::vector<int> out_data;
+    std::vector<std::string_view> tokens = {"1", "2", "3",  "4",  "5",  "6", "7",
                                        "8", "9", "10", "11", "12", "13"};
     ASSERT_THROW(decode_data(context, tokens, out_data), DataTooLong);
 }
 
 TEST_F(DataExtractorFixture, throws_if_finds_an_unknown_escape_char)
 {
-    std::vector<int> out_data;
-    std::vector<std::string> tokens = {R"("\u0001")"};
+    std::pmr::vector<int> out_data;
+    std::vector<std::string_view> tokens = {R"("\u0001")"};
 
     ASSERT_THROW(decode_data(context, tokens, out_data), UnknownEscapeSequence);
 }
@@ -42,8 +42,8 @@ TEST_F(DataExtractorFixture, throws_if_finds_an_unknown_escape_char)
 TEST_F(DataExtractorFixture, mark_8_ascii_sets_high_bit_on_string_bytes)
 {
     context.get_options().mark_8_ascii = true;
-    std::vector<int> out_data;
-    std::vector<std::string> tokens = {"\"AB\""};
+    std::pmr::vector<int> out_data;
+    std::vector<std::string_view> tokens = {"\"AB\""};
     decode_data(context, tokens, out_data);
     ASSERT_THAT(out_data[0], Eq('A' | 0x80));
     ASSERT_THAT(out_data[1], Eq('B' | 0x80));
@@ -52,8 +52,8 @@ TEST_F(DataExtractorFixture, mark_8_ascii_sets_high_bit_on_string_bytes)
 TEST_F(DataExtractorFixture, mark_8_ascii_does_not_affect_preceding_numeric_bytes)
 {
     context.get_options().mark_8_ascii = true;
-    std::vector<int> out_data;
-    std::vector<std::string> tokens = {"65", "\"B\""};
+    std::pmr::vector<int> out_data;
+    std::vector<std::string_view> tokens = {"65", "\"B\""};
     decode_data(context, tokens, out_data);
     ASSERT_THAT(out_data[0], Eq(65));
     ASSERT_THAT(out_data[1], Eq('B' | 0x80));
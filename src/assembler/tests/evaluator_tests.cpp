@@ -5,6 +5,9 @@
 
 #include "gmock/gmock.h"
 
+#include <thread>
+#include <vector>
+
 using namespace testing;
 
 struct EvaluateArgumentFixture : public Test
@@ -166,6 +169,19 @@ TEST_F(EvaluateArgumentFixture, throws_if_unknown_operation)
     ASSERT_THROW(evaluate_argument(context, "TEST.TEST"), UnknownOperation);
 }
 
+TEST_F(EvaluateArgumentFixture, evaluates_operands_surrounded_by_blanks)
+{
+    context.define_symbol("TEST", 2);
+    auto value = evaluate_argument(context, " \tTEST\t # 1 * 2 ");
+    ASSERT_THAT(value, Eq(1026));
+}
+
+TEST_F(EvaluateArgumentFixture, throws_if_operands_are_separated_by_a_comma_or_a_blank)
+{
+    ASSERT_THROW(evaluate_argument(context, "1,2"), UnknownOperation);
+    ASSERT_THROW(evaluate_argument(context, "1 2"), UnknownOperation);
+}
+
 TEST_F(EvaluateArgumentFixture, throws_if_invalid_number)
 {
     ASSERT_THROW(evaluate_argument(context, "2*0xfffffffffffffff"), InvalidNumber);
@@ -270,3 +286,37 @@ TEST_F(EvaluateArgumentFixture, throws_if_invalid_binary_literal)
 {
     ASSERT_THROW(evaluate_argument(context, "1012b"), InvalidNumber);
 }
+
+TEST(EvaluateArgument, evaluates_in_parallel_in_different_contexts)
+{
+    Options options;
+
+    std::vector<std::unique_ptr<Context>> contexts;
+    for (int index = 0; index < 4; index += 1)
+    {
+        contexts.push_back(std::make_unique<Context>(options));
+        contexts.back()->define_symbol("VALUE", index);
+    }
+
+    std::vector<int> mismatch_counts(contexts.size());
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < contexts.size(); index += 1)
+    {
+        threads.emplace_back([&context = *contexts[index], &mismatches = mismatch_counts[index],
+                              expected = static_cast<int>(index) * 2 + 1] {
+            for (int iteration = 0; iteration < 1000; iteration += 1)
+            {
+                if (evaluate_argument(context, "VALUE*2+1") != expected)
+                {
+                    mismatches += 1;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_THAT(mismatch_counts, Each(Eq(0)));
+}
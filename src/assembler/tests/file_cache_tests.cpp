@@ -0,0 +1,133 @@
+#include "gmock/gmock.h"
+
+#include "files/file_cache.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace testing;
+
+namespace
+{
+    std::filesystem::path write_file(const std::string& name, const std::string& content)
+    {
+        const auto path = std::filesystem::temp_directory_path() / name;
+        std::ofstream file{path, std::ios::binary};
+        file << content;
+        return path;
+    }
+}
+
+TEST(FileCache, has_no_statistics_when_constructed)
+{
+    FileCache file_cache;
+
+    ASSERT_THAT(file_cache.get_statistics().hits, Eq(0));
+    ASSERT_THAT(file_cache.get_statistics().misses, Eq(0));
+}
+
+TEST(FileCache, loads_a_file_once)
+{
+    const auto path = write_file("file_cache_tests_once.asm", "    LAA\n");
+
+    FileCache file_cache;
+    auto first_source = file_cache.get(path.string());
+    auto second_source = file_cache.get(path.string());
+    std::filesystem::remove(path);
+
+    ASSERT_THAT(first_source, NotNull());
+    ASSERT_THAT(second_source, Eq(first_source));
+    ASSERT_THAT(second_source->get_content(), Eq("    LAA\n"));
+    ASSERT_THAT(file_cache.get_statistics().hits, Eq(1));
+    ASSERT_THAT(file_cache.get_statistics().misses, Eq(1));
+}
+
+TEST(FileCache, identifies_files_by_their_canonical_path)
+{
+    const auto path = write_file("file_cache_tests_canonical.asm", "    LAA\n");
+    const auto other_path = path.parent_path() / "." / path.filename();
+
+    FileCache file_cache;
+    auto first_source = file_cache.get(path.string());
+    auto second_source = file_cache.get(other_path.string());
+    std::filesystem::remove(path);
+
+    ASSERT_THAT(second_source, Eq(first_source));
+    ASSERT_THAT(file_cache.get_statistics().hits, Eq(1));
+}
+
+TEST(FileCache, loads_a_file_again_when_its_size_changed)
+{
+    const auto path = write_file("file_cache_tests_changed.asm", "    LAA\n");
+
+    FileCache file_cache;
+    auto first_source = file_cache.get(path.string());
+    write_file("file_cache_tests_changed.asm", "    LAA\n    LBB\n");
+    auto second_source = file_cache.get(path.string());
+    std::filesystem::remove(path);
+
+    ASSERT_THAT(second_source, Ne(first_source));
+    ASSERT_THAT(second_source->get_content(), Eq("    LAA\n    LBB\n"));
+    ASSERT_THAT(file_cache.get_statistics().hits, Eq(0));
+    ASSERT_THAT(file_cache.get_statistics().misses, Eq(2));
+}
+
+TEST(FileCache, returns_null_for_a_missing_file)
+{
+    FileCache file_cache;
+
+    ASSERT_THAT(file_cache.get("this_file_does_not_exist.asm"), IsNull());
+    ASSERT_THAT(file_cache.get_statistics().misses, Eq(0));
+}
+
+TEST(FileCache, forgets_files_and_statistics_when_cleared)
+{
+    const auto path = write_file("file_cache_tests_cleared.asm", "    LAA\n");
+
+    FileCache file_cache;
+    auto first_source = file_cache.get(path.string());
+    file_cache.clear();
+    auto second_source = file_cache.get(path.string());
+    std::filesystem::remove(path);
+
+    ASSERT_THAT(second_source, Ne(first_source));
+    ASSERT_THAT(file_cache.get_statistics().hits, Eq(0));
+    ASSERT_THAT(file_cache.get_statistics().misses, Eq(1));
+}
+
+TEST(FileCache, forgets_the_least_recently_used_file_when_full)
+{
+    const auto first_path = write_file("file_cache_tests_lru_1.asm", "    LAA\n");
+    const auto second_path = write_file("file_cache_tests_lru_2.asm", "    LBB\n");
+    const auto third_path = write_file("file_cache_tests_lru_3.asm", "    LCC\n");
+
+    FileCache file_cache{2};
+    auto first_source = file_cache.get(first_path.string());
+    auto second_source = file_cache.get(second_path.string());
+    file_cache.get(first_path.string());
+    file_cache.get(third_path.string());
+
+    // The second file was the least recently used, so it is loaded again.
+    auto first_source_again = file_cache.get(first_path.string());
+    auto second_source_again = file_cache.get(second_path.string());
+    std::filesystem::remove(first_path);
+    std::filesystem::remove(second_path);
+    std::filesystem::remove(third_path);
+
+    ASSERT_THAT(first_source_again, Eq(first_source));
+    ASSERT_THAT(second_source_again, Ne(second_source));
+    ASSERT_THAT(file_cache.get_statistics().evictions, Eq(2));
+}
+
+TEST(FileCache, keeps_a_copy_of_the_files_when_asked)
+{
+    const auto path = write_file("file_cache_tests_copied.asm", "    LAA\n    LAB\n");
+
+    FileCache file_cache{FileCache::DEFAULT_CAPACITY, FileCache::Storage::COPIED};
+    auto source = file_cache.get(path.string());
+    write_file("file_cache_tests_copied.asm", "");
+    std::filesystem::remove(path);
+
+    ASSERT_THAT(source, NotNull());
+    ASSERT_THAT(source->get_content(), Eq("    LAA\n    LAB\n"));
+}
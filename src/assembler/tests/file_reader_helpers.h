@@ -0,0 +1,16 @@
+#ifndef INC_8008_ASSEMBLER_FILE_READER_HELPERS_H
+#define INC_8008_ASSEMBLER_FILE_READER_HELPERS_H
+
+#include "files/file_reader.h"
+
+#include <string>
+#include <vector>
+
+// Reads all the lines of a FileReader. The lines are views on the sources, which are released
+// once read, so they are copied.
+inline std::vector<std::string> read_all_lines(FileReader& file_reader)
+{
+    return {std::begin(file_reader), std::end(file_reader)};
+}
+
+#endif //INC_8008_ASSEMBLER_FILE_READER_HELPERS_H
@@ -1,8 +1,11 @@
 #include "gmock/gmock.h"
 
+#include "file_reader_helpers.h"
 #include "files/file_reader.h"
 
 #include <deque>
+#include <filesystem>
+#include <fstream>
 
 using namespace testing;
 
@@ -60,8 +63,7 @@ TEST(FileReader, iterates_on_lines)
     FileReader file_reader;
     file_reader.append(std::move(content), std::string_view());
 
-    std::vector<std::string> all_lines;
-    std::copy(std::begin(file_reader), std::end(file_reader), std::back_inserter(all_lines));
+    const auto all_lines = read_all_lines(file_reader);
 
     ASSERT_THAT(all_lines.size(), Eq(2));
 }
@@ -78,8 +80,7 @@ TEST(FileReader, chains_two_input_streams)
     file_reader.append(std::move(content_1), std::string_view());
     file_reader.append(std::move(content_2), std::string_view());
 
-    std::vector<std::string> all_lines;
-    std::copy(std::begin(file_reader), std::end(file_reader), std::back_inserter(all_lines));
+    const auto all_lines = read_all_lines(file_reader);
 
     ASSERT_THAT(all_lines.size(), Eq(4));
 }
@@ -96,8 +97,7 @@ TEST(FileReader, chains_two_input_streams_updates_name_tag)
     file_reader.append(std::move(content_1), "tag_1");
     file_reader.append(std::move(content_2), "tag_2");
 
-    std::vector<std::string> all_lines;
-    std::copy(std::begin(file_reader), std::end(file_reader), std::back_inserter(all_lines));
+    const auto all_lines = read_all_lines(file_reader);
 
     ASSERT_THAT(file_reader.get_name_tag(), Eq("tag_2"));
 }
@@ -116,8 +116,7 @@ TEST(FileReader, chains_three_input_streams_and_ignores_empty_one)
     file_reader.append(std::move(content_2), std::string_view());
     file_reader.append(std::move(content_3), std::string_view());
 
-    std::vector<std::string> all_lines;
-    std::copy(std::begin(file_reader), std::end(file_reader), std::back_inserter(all_lines));
+    const auto all_lines = read_all_lines(file_reader);
 
     ASSERT_THAT(all_lines.size(), Eq(4));
     ASSERT_THAT(file_reader.get_line_number(), Eq(2));
@@ -202,8 +201,7 @@ TEST(FileReader, calls_back_a_function_when_an_appended_stream_is_exhausted)
     file_reader.append(std::move(content_1), std::string_view(), [&count]() { count += 1; });
     file_reader.append(std::move(content_2), std::string_view(), [&count]() { count += 3; });
 
-    std::vector<std::string> all_lines;
-    std::copy(std::begin(file_reader), std::end(file_reader), std::back_inserter(all_lines));
+    const auto all_lines = read_all_lines(file_reader);
 
     ASSERT_THAT(count, Eq(4));
 }
@@ -236,4 +234,77 @@ TEST(FileReader, calls_back_a_function_when_an_inserted_stream_is_exhausted)
     ++it;
 
     ASSERT_THAT(count, Eq(4));
-}
\ No newline at end of file
+}
+
+TEST(FileReader, removes_carriage_returns_at_end_of_lines)
+{
+    const std::string input_value{"first line\r\nsecond line\r\n\r\nlast line\r"};
+    auto content = std::make_unique<std::istringstream>(input_value);
+
+    FileReader file_reader;
+    file_reader.append(std::move(content), std::string_view());
+
+    const auto all_lines = read_all_lines(file_reader);
+
+    ASSERT_THAT(all_lines, ElementsAre("first line", "second line", "", "last line"));
+}
+
+TEST(FileReader, reads_lines_from_a_source_buffer)
+{
+    auto source = SourceBuffer::from_string("first line\nsecond line\n");
+
+    FileReader file_reader;
+    file_reader.append(source, "tag");
+
+    // As the source is still held here, the lines can be kept as views.
+    std::vector<std::string_view> all_lines(std::begin(file_reader), std::end(file_reader));
+
+    ASSERT_THAT(all_lines, ElementsAre("first line", "second line"));
+    ASSERT_THAT(all_lines[0].data(), Eq(source->get_content().data()));
+}
+
+TEST(FileReader, reads_lines_from_a_mapped_file)
+{
+    const auto path = std::filesystem::temp_directory_path() / "file_reader_tests_mapped.asm";
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << "    LAA\r\n    LBB\n";
+    }
+
+    auto source = SourceBuffer::from_file(path.string());
+    ASSERT_THAT(source, NotNull());
+
+    FileReader file_reader;
+    file_reader.append(source, "tag");
+
+    const auto all_lines = read_all_lines(file_reader);
+    std::filesystem::remove(path);
+
+    ASSERT_THAT(all_lines, ElementsAre("    LAA", "    LBB"));
+}
+
+TEST(FileReader, cannot_map_a_missing_file)
+{
+    ASSERT_THAT(SourceBuffer::from_file("this_file_does_not_exist.asm"), IsNull());
+}
+
+TEST(FileReader, gives_the_source_of_the_current_line)
+{
+    auto source_1 = SourceBuffer::from_string("first line\nsecond line");
+    auto source_2 = SourceBuffer::from_string("interruption");
+
+    FileReader file_reader;
+    file_reader.append(source_1, "tag_1");
+
+    auto it = std::begin(file_reader);
+    ASSERT_THAT(file_reader.get_current_source(), Eq(source_1));
+
+    file_reader.insert_now(source_2, "tag_2");
+    ASSERT_THAT(file_reader.get_current_source(), Eq(source_1));
+
+    ++it;
+    ASSERT_THAT(file_reader.get_current_source(), Eq(source_2));
+
+    ++it;
+    ASSERT_THAT(file_reader.get_current_source(), Eq(source_1));
+}
@@ -202,25 +202,56 @@ struct SecondPassFixture : public InstructionFixture
 /// TEST FOR PARSING THE INSTRUCTION
 TEST(PseudoOpcodes, can_be_parsed_as_enum)
 {
-    ASSERT_THAT(instruction_to_enum(""), Eq(InstructionEnum::EMPTY));
+    ASSERT_THAT(classify_instruction("", OLD).instruction, Eq(InstructionEnum::EMPTY));
 
-    ASSERT_THAT(instruction_to_enum("EQU"), Eq(InstructionEnum::EQU));
-    ASSERT_THAT(instruction_to_enum("equ"), Eq(InstructionEnum::EQU));
+    ASSERT_THAT(classify_instruction("EQU", OLD).instruction, Eq(InstructionEnum::EQU));
+    ASSERT_THAT(classify_instruction("equ", OLD).instruction, Eq(InstructionEnum::EQU));
 
-    ASSERT_THAT(instruction_to_enum("END"), Eq(InstructionEnum::END));
-    ASSERT_THAT(instruction_to_enum("end"), Eq(InstructionEnum::END));
+    ASSERT_THAT(classify_instruction("END", OLD).instruction, Eq(InstructionEnum::END));
+    ASSERT_THAT(classify_instruction("end", OLD).instruction, Eq(InstructionEnum::END));
 
-    ASSERT_THAT(instruction_to_enum("CPU"), Eq(InstructionEnum::CPU));
-    ASSERT_THAT(instruction_to_enum("cpu"), Eq(InstructionEnum::CPU));
+    ASSERT_THAT(classify_instruction("CPU", OLD).instruction, Eq(InstructionEnum::CPU));
+    ASSERT_THAT(classify_instruction("cpu", OLD).instruction, Eq(InstructionEnum::CPU));
 
-    ASSERT_THAT(instruction_to_enum("ORG"), Eq(InstructionEnum::ORG));
-    ASSERT_THAT(instruction_to_enum("org"), Eq(InstructionEnum::ORG));
+    ASSERT_THAT(classify_instruction("ORG", OLD).instruction, Eq(InstructionEnum::ORG));
+    ASSERT_THAT(classify_instruction("org", OLD).instruction, Eq(InstructionEnum::ORG));
 
-    ASSERT_THAT(instruction_to_enum("DATA"), Eq(InstructionEnum::DATA));
-    ASSERT_THAT(instruction_to_enum("data"), Eq(InstructionEnum::DATA));
+    ASSERT_THAT(classify_instruction("DATA", OLD).instruction, Eq(InstructionEnum::DATA));
+    ASSERT_THAT(classify_instruction("data", OLD).instruction, Eq(InstructionEnum::DATA));
 
-    ASSERT_THAT(instruction_to_enum("LAA"), Eq(InstructionEnum::OTHER));
-    ASSERT_THAT(instruction_to_enum("garbage"), Eq(InstructionEnum::OTHER));
+    ASSERT_THAT(classify_instruction("LAA", OLD).instruction, Eq(InstructionEnum::OTHER));
+    ASSERT_THAT(classify_instruction("garbage", OLD).instruction, Eq(InstructionEnum::OTHER));
+}
+
+TEST(PseudoOpcodes, directives_and_macro_calls_are_classified_in_both_syntaxes)
+{
+    for (const auto syntax_type : {OLD, NEW})
+    {
+        ASSERT_THAT(classify_instruction(".MACRO", syntax_type).instruction,
+                    Eq(InstructionEnum::MACRO));
+        ASSERT_THAT(classify_instruction(".endmacro", syntax_type).instruction,
+                    Eq(InstructionEnum::ENDMACRO));
+        ASSERT_THAT(classify_instruction("db", syntax_type).instruction,
+                    Eq(InstructionEnum::DATA));
+        ASSERT_THAT(classify_instruction(".my_macro", syntax_type).instruction,
+                    Eq(InstructionEnum::MACRO_CALL));
+        ASSERT_THAT(classify_instruction("db", syntax_type).opcode_index,
+                    Eq(InstructionKind::NO_OPCODE));
+    }
+}
+
+TEST(PseudoOpcodes, mnemonics_are_classified_with_their_opcode)
+{
+    const auto old_kind = classify_instruction("lai", OLD);
+    ASSERT_THAT(old_kind.instruction, Eq(InstructionEnum::OTHER));
+    ASSERT_THAT(old_kind.opcode_index, Ne(InstructionKind::NO_OPCODE));
+
+    const auto new_kind = classify_instruction("MVI", NEW);
+    ASSERT_THAT(new_kind.instruction, Eq(InstructionEnum::OTHER));
+    ASSERT_THAT(new_kind.opcode_index, Ne(InstructionKind::NO_OPCODE));
+
+    ASSERT_THAT(classify_instruction("MVI", OLD).opcode_index, Eq(InstructionKind::NO_OPCODE));
+    ASSERT_THAT(classify_instruction("garbage", NEW).instruction, Eq(InstructionEnum::OTHER));
 }
 
 /// TESTS FOR THE ADDRESS EVALUATION
@@ -2,6 +2,9 @@
 
 #include "gmock/gmock.h"
 
+#include <optional>
+#include <string>
+
 using namespace testing;
 
 TEST(LineTokenizer, parse_empty_line)
@@ -196,3 +199,34 @@ TEST(LineTokenizer, extracts_parameter_with_character)
     ASSERT_THAT(tokenizer.arguments[0], Eq("b"));
     ASSERT_THAT(tokenizer.arguments[1], Eq("'0'-1"));
 }
+
+TEST(LineTokenizer, joins_a_character_and_a_spaced_expression)
+{
+    LineTokenizer tokenizer{"     mvi     b,'0' - 1"};
+    ASSERT_THAT(tokenizer.arguments, SizeIs(2));
+    ASSERT_THAT(tokenizer.arguments[1], Eq("'0'- 1"));
+}
+
+TEST(LineTokenizer, tokens_are_views_on_the_line)
+{
+    const std::string line{"LABEL: DATA 1,'0'-1 ; Comment"};
+    LineTokenizer tokenizer{line};
+    const auto is_in_line = [&line](std::string_view token) {
+        const auto line_end = line.data() + line.size();
+        return token.data() >= line.data() && token.data() + token.size() <= line_end;
+    };
+    ASSERT_TRUE(is_in_line(tokenizer.label));
+    ASSERT_TRUE(is_in_line(tokenizer.opcode));
+    ASSERT_TRUE(is_in_line(tokenizer.arguments[0]));
+    ASSERT_TRUE(is_in_line(tokenizer.arguments[1]));
+    ASSERT_TRUE(is_in_line(tokenizer.comment));
+}
+
+TEST(LineTokenizer, keeps_joined_arguments_in_copies)
+{
+    std::optional<LineTokenizer> tokenizer{LineTokenizer{" DATA 'A' + 1,'B' + 2,3"}};
+    const LineTokenizer copy = *tokenizer;
+    tokenizer.reset();
+
+    ASSERT_THAT(copy.arguments, ElementsAre("'A'+ 1", "'B'+ 2", "3"));
+}
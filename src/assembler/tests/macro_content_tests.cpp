@@ -1,5 +1,6 @@
 #include "macro_content.h"
 
+#include "file_reader_helpers.h"
 #include "files/file_reader.h"
 
 #include "gmock/gmock.h"
@@ -22,13 +23,47 @@ TEST(MacroContent, can_be_filled_with_lines)
     macro.append_line("first line");
     macro.append_line("second line");
 
-    auto stream = macro.get_line_stream();
-
     FileReader file_reader;
-    file_reader.append(std::move(stream), std::string_view());
+    file_reader.append(macro.get_body(), std::string_view());
 
-    std::vector<std::string> all_lines;
-    std::copy(std::begin(file_reader), std::end(file_reader), std::back_inserter(all_lines));
+    const auto all_lines = read_all_lines(file_reader);
 
     ASSERT_THAT(all_lines, SizeIs(2));
 }
+
+TEST(MacroContent, gives_the_template_of_its_lines)
+{
+    MacroContent macro{"my_macro", {"Param"}};
+
+    macro.append_line("label: LAI param");
+
+    const auto* line_template = macro.get_line_template(macro.get_body(), 1);
+
+    ASSERT_THAT(line_template, NotNull());
+    ASSERT_THAT(line_template->tokens.label, Eq("label"));
+    ASSERT_THAT(line_template->tokens.opcode, Eq("LAI"));
+    ASSERT_THAT(line_template->tokens.arguments, ElementsAre("param"));
+}
+
+TEST(MacroContent, associates_arguments_to_parameters)
+{
+    MacroContent macro{"my_macro", {"first", "second"}};
+
+    macro.append_line("    DATA SECOND, 1, First");
+
+    const auto* line_template = macro.get_line_template(macro.get_body(), 1);
+
+    ASSERT_THAT(line_template->parameter_indices,
+                ElementsAre(1, MacroContent::LineTemplate::NO_PARAMETER, 0));
+}
+
+TEST(MacroContent, has_no_template_for_other_sources)
+{
+    MacroContent macro{"my_macro", {}};
+
+    macro.append_line("    LAA");
+    const auto other_source = SourceBuffer::from_string("    LAA\n");
+
+    ASSERT_THAT(macro.get_line_template(other_source, 1), IsNull());
+    ASSERT_THAT(macro.get_line_template(macro.get_body(), 2), IsNull());
+}
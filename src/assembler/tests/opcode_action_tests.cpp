@@ -1,4 +1,5 @@
 #include "opcodes/opcode_action.h"
+#include "opcodes/any_opcode_action.h"
 
 #include "byte_writer.h"
 #include "options.h"
@@ -39,7 +40,7 @@ TEST_F(OpcodeActionFixture, no_arg_action_emits_one_byte)
 TEST_F(OpcodeActionFixture, one_byte_arg_action_emits_two_bytes)
 {
     Opcode::OpcodeByteType opcode_LAI = 0006;
-    std::vector<std::string> arguments = {"0x10"};
+    std::vector<CompiledExpression> arguments{{context, "0x10"}};
     auto action = std::make_unique<OpcodeActionOneByteArg>(context, opcode_LAI, current_address,
                                                            arguments);
 
@@ -54,7 +55,7 @@ TEST_F(OpcodeActionFixture, one_byte_arg_action_emits_two_bytes)
 TEST_F(OpcodeActionFixture, two_byte_arg_action_emits_three_bytes)
 {
     Opcode::OpcodeByteType opcode_CAL = 0106;
-    std::vector<std::string> arguments = {"0x1000"};
+    std::vector<CompiledExpression> arguments{{context, "0x1000"}};
     auto action = std::make_unique<OpcodeActionTwoByteArg>(context, opcode_CAL, current_address,
                                                            arguments);
 
@@ -70,7 +71,7 @@ TEST_F(OpcodeActionFixture, two_byte_arg_action_emits_three_bytes)
 TEST_F(OpcodeActionFixture, inp_out_action_emits_one_byte)
 {
     Opcode::OpcodeByteType opcode_INP = 0101;
-    std::vector<std::string> arguments = {"0x1"};
+    std::vector<CompiledExpression> arguments{{context, "0x1"}};
     auto action = std::make_unique<OpcodeActionInpOut>(context, opcode_INP, current_address,
                                                        arguments, "inp");
 
@@ -84,7 +85,7 @@ TEST_F(OpcodeActionFixture, inp_out_action_emits_one_byte)
 TEST_F(OpcodeActionFixture, rst_action_emits_one_byte)
 {
     Opcode::OpcodeByteType opcode_RST = 0005;
-    std::vector<std::string> arguments = {"1"};
+    std::vector<CompiledExpression> arguments{{context, "1"}};
     auto action =
             std::make_unique<OpcodeActionRst>(context, opcode_RST, current_address, arguments);
 
@@ -98,7 +99,7 @@ TEST_F(OpcodeActionFixture, rst_action_emits_one_byte)
 TEST_F(OpcodeActionFixture, two_byte_arg_accepts_max_valid_address)
 {
     Opcode::OpcodeByteType opcode_CAL = 0106;
-    std::vector<std::string> arguments = {"16383"};
+    std::vector<CompiledExpression> arguments{{context, "16383"}};
     ASSERT_NO_THROW(
         std::make_unique<OpcodeActionTwoByteArg>(context, opcode_CAL, current_address, arguments)
     );
@@ -107,9 +108,32 @@ TEST_F(OpcodeActionFixture, two_byte_arg_accepts_max_valid_address)
 TEST_F(OpcodeActionFixture, two_byte_arg_rejects_address_above_max)
 {
     Opcode::OpcodeByteType opcode_CAL = 0106;
-    std::vector<std::string> arguments = {"16384"};
+    std::vector<CompiledExpression> arguments{{context, "16384"}};
     ASSERT_THROW(
         std::make_unique<OpcodeActionTwoByteArg>(context, opcode_CAL, current_address, arguments),
         ExpectedArgumentWithinLimits
     );
 }
+
+TEST_F(OpcodeActionFixture, creates_the_action_of_the_rule_of_the_opcode)
+{
+    const Opcode opcode_LAI{"LAI", 0006, ONE_BYTE_ARG};
+    std::vector<CompiledExpression> arguments{{context, "0x10"}};
+    const auto action = create_opcode_action(context, opcode_LAI, current_address, arguments);
+
+    ASSERT_THAT(std::holds_alternative<OpcodeActionOneByteArg>(action), IsTrue());
+
+    emit_byte_stream(action, byte_writer);
+    byte_writer.write_end();
+
+    ASSERT_THAT(byte_buffer.str()[0], Eq(static_cast<char>(0006)));
+    ASSERT_THAT(byte_buffer.str()[1], Eq(static_cast<char>(0x10)));
+}
+
+TEST_F(OpcodeActionFixture, rejects_the_wrong_argument_count_for_the_rule)
+{
+    const Opcode opcode_LAA{"LAA", 0300, NO_ARG};
+    std::vector<CompiledExpression> arguments{{context, "1"}};
+    ASSERT_THROW(create_opcode_action(context, opcode_LAA, current_address, arguments),
+                 UnexpectedArgumentCount);
+}
@@ -1,89 +1,119 @@
+#include "instruction.h"
 #include "opcodes/opcodes.h"
 
 #include "gmock/gmock.h"
 
-using namespace testing;
-
-TEST(Opcode, can_select_the_opcode_matcher)
-{
-    auto matcher = get_opcode_matcher(OLD);
+#include <string_view>
+#include <tuple>
+#include <vector>
 
-    std::vector<std::string> arguments{};
-    auto [found, found_opcode, consume] = matcher("LAB", arguments);
+using namespace testing;
 
-    ASSERT_THAT(found, IsTrue());
-    ASSERT_THAT(found_opcode.rule, Eq(NO_ARG));
-    ASSERT_THAT(found_opcode.code, Eq(0301));
-}
+// Finds an opcode the way an instruction does: the mnemonic is classified, then the opcode at
+// its index is decoded.
+struct OpcodeSyntaxFixture : public Test
+{
+    explicit OpcodeSyntaxFixture(SyntaxType syntax_type) : syntax_type{syntax_type} {}
+
+    [[nodiscard]] bool is_opcode(std::string_view mnemonic) const
+    {
+        return classify_instruction(mnemonic, syntax_type).opcode_index !=
+               InstructionKind::NO_OPCODE;
+    }
+
+    [[nodiscard]] std::tuple<Opcode, std::size_t>
+    decode(std::string_view mnemonic, const std::vector<std::string_view>& arguments = {}) const
+    {
+        const auto [instruction, opcode_index] = classify_instruction(mnemonic, syntax_type);
+        if (opcode_index == InstructionKind::NO_OPCODE)
+        {
+            throw UndefinedOpcode(mnemonic);
+        }
+        return decode_opcode(syntax_type, opcode_index, mnemonic, arguments);
+    }
+
+    SyntaxType syntax_type;
+};
 
-struct OldOpcodeSyntaxFixture : public Test
+struct OldOpcodeSyntaxFixture : public OpcodeSyntaxFixture
 {
-    OldOpcodeSyntaxFixture() : matcher{get_opcode_matcher(OLD)} {}
-    std::vector<std::string> arguments{};
-    matcher_signature* matcher;
+    OldOpcodeSyntaxFixture() : OpcodeSyntaxFixture{OLD} {}
 };
 
 TEST_F(OldOpcodeSyntaxFixture, understands_no_arg_opcode)
 {
-    auto [found, found_opcode, consume] = matcher("LAA", arguments);
+    auto [found_opcode, consumed] = decode("LAA");
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(NO_ARG));
     ASSERT_THAT(found_opcode.code, Eq(0300));
+    ASSERT_THAT(consumed, Eq(0));
+}
+
+TEST_F(OldOpcodeSyntaxFixture, understands_no_arg_opcode_with_different_registers)
+{
+    auto [found_opcode, consumed] = decode("LAB");
+
+    ASSERT_THAT(found_opcode.rule, Eq(NO_ARG));
+    ASSERT_THAT(found_opcode.code, Eq(0301));
 }
 
 TEST_F(OldOpcodeSyntaxFixture, understands_one_byte_arg_opcode)
 {
-    std::vector<std::string> arguments{};
-    auto [found, found_opcode, consume] = matcher("LAI", arguments);
+    auto [found_opcode, consumed] = decode("LAI", {"10"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(ONE_BYTE_ARG));
     ASSERT_THAT(found_opcode.code, Eq(0006));
+    ASSERT_THAT(consumed, Eq(0));
 }
 
 TEST_F(OldOpcodeSyntaxFixture, understands_address_arg_opcode)
 {
-    std::vector<std::string> arguments{};
-    auto [found, found_opcode, consume] = matcher("JMP", arguments);
+    auto [found_opcode, consumed] = decode("JMP", {"START"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(ADDRESS_ARG));
     ASSERT_THAT(found_opcode.code, Eq(0104));
 }
 
 TEST_F(OldOpcodeSyntaxFixture, understands_inpout_opcode)
 {
-    std::vector<std::string> arguments{};
-    auto [found, found_opcode, consume] = matcher("INP", arguments);
+    auto [found_opcode, consumed] = decode("INP", {"1"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(INP_OUT));
     ASSERT_THAT(found_opcode.code, Eq(0101));
 }
 
 TEST_F(OldOpcodeSyntaxFixture, understands_rst_opcode)
 {
-    std::vector<std::string> arguments{};
-    auto [found, found_opcode, consume] = matcher("RST", arguments);
+    auto [found_opcode, consumed] = decode("RST", {"1"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(RST));
     ASSERT_THAT(found_opcode.code, Eq(0005));
 }
 
-struct NewOpcodeSyntaxFixture : public Test
+TEST_F(OldOpcodeSyntaxFixture, finds_opcodes_without_case)
+{
+    auto [found_opcode, consumed] = decode("jmp", {"START"});
+
+    ASSERT_THAT(found_opcode.code, Eq(0104));
+}
+
+TEST_F(OldOpcodeSyntaxFixture, does_not_find_unknown_opcodes)
 {
-    NewOpcodeSyntaxFixture() : matcher{get_opcode_matcher(NEW)} {}
-    matcher_signature* matcher;
+    ASSERT_THAT(is_opcode("JMPS"), IsFalse());
+    ASSERT_THAT(is_opcode("JM"), IsFalse());
+    ASSERT_THAT(is_opcode(""), IsFalse());
+    ASSERT_THAT(is_opcode("ORG"), IsFalse());
+}
+
+struct NewOpcodeSyntaxFixture : public OpcodeSyntaxFixture
+{
+    NewOpcodeSyntaxFixture() : OpcodeSyntaxFixture{NEW} {}
 };
 
 TEST_F(NewOpcodeSyntaxFixture, understands_mov_opcode)
 {
-    std::vector<std::string> arguments{"A", "B"};
-    auto [found, found_opcode, consumed] = matcher("MOV", arguments);
+    auto [found_opcode, consumed] = decode("MOV", {"A", "B"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(NO_ARG));
     ASSERT_THAT(found_opcode.code, Eq(0301));
     ASSERT_THAT(consumed, Eq(2));
@@ -91,22 +121,18 @@ TEST_F(NewOpcodeSyntaxFixture, understands_mov_opcode)
 
 TEST_F(NewOpcodeSyntaxFixture, mov_missing_one_argument_is_a_syntax_error)
 {
-    std::vector<std::string> arguments{"A"};
-    ASSERT_THROW(matcher("MOV", arguments), SyntaxError);
+    ASSERT_THROW(decode("MOV", {"A"}), SyntaxError);
 }
 
 TEST_F(NewOpcodeSyntaxFixture, mov_missing_first_argument_is_a_syntax_error)
 {
-    std::vector<std::string> arguments{"", "B"};
-    ASSERT_THROW(matcher("MOV", arguments), SyntaxError);
+    ASSERT_THROW(decode("MOV", {"", "B"}), SyntaxError);
 }
 
 TEST_F(NewOpcodeSyntaxFixture, understands_mov_opcode_with_different_registers)
 {
-    std::vector<std::string> arguments{"M", "E"};
-    auto [found, found_opcode, consumed] = matcher("MOV", arguments);
+    auto [found_opcode, consumed] = decode("MOV", {"M", "E"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(NO_ARG));
     ASSERT_THAT(found_opcode.code, Eq(0374));
     ASSERT_THAT(consumed, Eq(2));
@@ -114,10 +140,8 @@ TEST_F(NewOpcodeSyntaxFixture, understands_mov_opcode_with_different_registers)
 
 TEST_F(NewOpcodeSyntaxFixture, understands_mvi_opcode)
 {
-    std::vector<std::string> arguments{"C"};
-    auto [found, found_opcode, consumed] = matcher("MVI", arguments);
+    auto [found_opcode, consumed] = decode("MVI", {"C", "10"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(ONE_BYTE_ARG));
     ASSERT_THAT(found_opcode.code, Eq(0026));
     ASSERT_THAT(consumed, Eq(1));
@@ -125,17 +149,13 @@ TEST_F(NewOpcodeSyntaxFixture, understands_mvi_opcode)
 
 TEST_F(NewOpcodeSyntaxFixture, mov_with_a_number_as_first_argument_is_a_syntax_error)
 {
-    std::vector<std::string> arguments{"1", "B"};
-    ASSERT_THROW(matcher("MVI", arguments), SyntaxError);
+    ASSERT_THROW(decode("MVI", {"1", "B"}), SyntaxError);
 }
 
-
 TEST_F(NewOpcodeSyntaxFixture, understands_add_opcode)
 {
-    std::vector<std::string> arguments{"D"};
-    auto [found, found_opcode, consumed] = matcher("ADD", arguments);
+    auto [found_opcode, consumed] = decode("ADD", {"D"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(NO_ARG));
     ASSERT_THAT(found_opcode.code, Eq(0203));
     ASSERT_THAT(consumed, Eq(1));
@@ -143,11 +163,15 @@ TEST_F(NewOpcodeSyntaxFixture, understands_add_opcode)
 
 TEST_F(NewOpcodeSyntaxFixture, understands_adi_opcode)
 {
-    std::vector<std::string> arguments{"10"};
-    auto [found, found_opcode, consumed] = matcher("ADI", arguments);
+    auto [found_opcode, consumed] = decode("ADI", {"10"});
 
-    ASSERT_THAT(found, IsTrue());
     ASSERT_THAT(found_opcode.rule, Eq(ONE_BYTE_ARG));
     ASSERT_THAT(found_opcode.code, Eq(0004));
     ASSERT_THAT(consumed, Eq(0));
 }
+
+TEST_F(NewOpcodeSyntaxFixture, does_not_find_unknown_opcodes)
+{
+    ASSERT_THAT(is_opcode("LAA"), IsFalse());
+    ASSERT_THAT(is_opcode("MOVE"), IsFalse());
+}
@@ -0,0 +1,120 @@
+#include "parsed_line_storage.h"
+
+#include "context_stack.h"
+#include "files/file_reader.h"
+#include "files/source_buffer.h"
+#include "first_pass.h"
+#include "options.h"
+
+#include "gmock/gmock.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+// Counts the blocks taken from the heap, and the bytes not given back yet.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocation_count{0};
+    std::size_t bytes_in_use{0};
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        allocation_count += 1;
+        bytes_in_use += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        bytes_in_use -= bytes;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+struct ParsedLineStorageFixture : public Test
+{
+    void parse(std::string source)
+    {
+        file_reader.append(SourceBuffer::from_string(std::move(source)), "main.asm");
+        first_pass(ContextStack{options}, file_reader, parsed_line_storage);
+    }
+
+    Options options;
+    FileReader file_reader;
+    ParsedLineStorage parsed_line_storage;
+};
+
+TEST_F(ParsedLineStorageFixture, keeps_the_lines_in_order)
+{
+    parse("start:  LAI 1\n"
+          "        LBI 2\n");
+
+    ASSERT_THAT(parsed_line_storage.size(), Eq(2));
+    ASSERT_THAT(parsed_line_storage[0].line, Eq("start:  LAI 1"));
+    ASSERT_THAT(parsed_line_storage[0].line_number, Eq(1));
+    ASSERT_THAT(parsed_line_storage[1].line_address, Eq(2));
+    ASSERT_THAT(parsed_line_storage[1].name_tag, Eq("main.asm"));
+
+    std::vector<std::string_view> lines;
+    for (const auto parsed_line : parsed_line_storage)
+    {
+        lines.push_back(parsed_line.line);
+    }
+    ASSERT_THAT(lines, ElementsAre("start:  LAI 1", "        LBI 2"));
+}
+
+TEST_F(ParsedLineStorageFixture, keeps_only_the_tokens_of_the_latest_line)
+{
+    parse("start:  LAI 1\n"
+          "next:   LBI 2\n");
+
+    ASSERT_THAT(parsed_line_storage.latest_tokens().label, Eq("next"));
+    ASSERT_THAT(parsed_line_storage.latest_tokens().opcode, Eq("LBI"));
+}
+
+TEST_F(ParsedLineStorageFixture, refers_to_the_context_of_each_line)
+{
+    parse("        LAI 1\n"
+          "        .context push\n"
+          "value:  EQU 2\n"
+          "        .context pop\n"
+          "        LBI 2\n");
+
+    const auto& outer_context = parsed_line_storage[0].context;
+    ASSERT_THAT(&parsed_line_storage[2].context, Ne(&outer_context));
+    ASSERT_THAT(&parsed_line_storage[4].context, Eq(&outer_context));
+}
+
+TEST(ParsedLineStorage, allocates_the_instructions_in_an_arena_released_with_the_storage)
+{
+    std::string source;
+    for (int line = 0; line < 1000; line += 1)
+    {
+        source += "        LAI 1+2\n        DATA 1, 2, 3\n";
+    }
+
+    CountingResource upstream;
+    {
+        const Options options;
+        FileReader file_reader;
+        file_reader.append(SourceBuffer::from_string(std::move(source)), "main.asm");
+        ParsedLineStorage parsed_line_storage{&upstream};
+        first_pass(ContextStack{options}, file_reader, parsed_line_storage);
+
+        ASSERT_THAT(parsed_line_storage.size(), Eq(2000));
+        // The arena takes growing blocks, rather than a buffer for each operand.
+        ASSERT_THAT(upstream.allocation_count, AllOf(Gt(0), Lt(100)));
+    }
+    ASSERT_THAT(upstream.bytes_in_use, Eq(0));
+}
@@ -0,0 +1,48 @@
+#include "perfect_hash.h"
+
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+namespace
+{
+    constexpr std::array<std::string_view, 4> names{"mov", "MVI", "interrupt", "interrupted"};
+    constexpr PerfectHashTable<names.size(), 4> table{names};
+    using Table = decltype(table);
+}
+
+TEST(PerfectHashTable, is_built_at_compile_time)
+{
+    static_assert(table.is_perfect());
+    static_assert(table.find("mvi") == 1);
+}
+
+TEST(PerfectHashTable, finds_names_without_case)
+{
+    ASSERT_THAT(table.find("mov"), Eq(0));
+    ASSERT_THAT(table.find("MoV"), Eq(0));
+    ASSERT_THAT(table.find("mvi"), Eq(1));
+}
+
+TEST(PerfectHashTable, compares_names_longer_than_the_key)
+{
+    ASSERT_THAT(table.find("INTERRUPT"), Eq(2));
+    ASSERT_THAT(table.find("interrupted"), Eq(3));
+    ASSERT_THAT(table.find("interrupter"), Eq(Table::NOT_FOUND));
+}
+
+TEST(PerfectHashTable, does_not_find_other_names)
+{
+    ASSERT_THAT(table.find(""), Eq(Table::NOT_FOUND));
+    ASSERT_THAT(table.find("mo"), Eq(Table::NOT_FOUND));
+    ASSERT_THAT(table.find("movs"), Eq(Table::NOT_FOUND));
+    ASSERT_THAT(table.find(std::string_view{"mov\0", 4}), Eq(Table::NOT_FOUND));
+}
+
+TEST(PerfectHashTable, is_not_perfect_with_duplicated_names)
+{
+    constexpr std::array<std::string_view, 2> duplicated_names{"mov", "MOV"};
+    constexpr PerfectHashTable<duplicated_names.size(), 4> duplicated_table{duplicated_names};
+
+    ASSERT_THAT(duplicated_table.is_perfect(), IsFalse());
+}
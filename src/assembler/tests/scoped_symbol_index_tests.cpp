@@ -0,0 +1,72 @@
+#include "scoped_symbol_index.h"
+
+#include "gmock/gmock.h"
+
+#include <vector>
+
+using namespace testing;
+
+struct ScopedSymbolIndexFixture : public Test
+{
+    ScopedSymbolIndex index;
+    ScopedSymbolIndex::ScopePath root{index.open_scope({})};
+    ScopedSymbolIndex::ScopePath child{index.open_scope(root)};
+    ScopedSymbolIndex::ScopePath grandchild{index.open_scope(child)};
+    ScopedSymbolIndex::ScopePath sibling{index.open_scope(root)};
+};
+
+TEST_F(ScopedSymbolIndexFixture, sees_the_symbols_of_the_ancestors)
+{
+    index.define_symbol(root, 0, 10);
+
+    ASSERT_THAT(index.get_symbol_value(grandchild, 0), Eq(std::make_tuple(true, 10)));
+    ASSERT_THAT(index.get_symbol_value(sibling, 0), Eq(std::make_tuple(true, 10)));
+}
+
+TEST_F(ScopedSymbolIndexFixture, does_not_see_the_symbols_of_other_scopes)
+{
+    index.define_symbol(child, 0, 10);
+
+    ASSERT_THAT(index.get_symbol_value(root, 0), Eq(std::make_tuple(false, 0)));
+    ASSERT_THAT(index.get_symbol_value(sibling, 0), Eq(std::make_tuple(false, 0)));
+    ASSERT_THAT(index.get_symbol_value(child, 1), Eq(std::make_tuple(false, 0)));
+}
+
+TEST_F(ScopedSymbolIndexFixture, the_nearest_definition_wins)
+{
+    index.define_symbol(child, 0, 10);
+    index.define_symbol(root, 0, 20);
+    index.define_symbol(grandchild, 0, 30);
+
+    ASSERT_THAT(index.get_symbol_value(grandchild, 0), Eq(std::make_tuple(true, 30)));
+    ASSERT_THAT(index.get_symbol_value(child, 0), Eq(std::make_tuple(true, 10)));
+    ASSERT_THAT(index.get_symbol_value(sibling, 0), Eq(std::make_tuple(true, 20)));
+}
+
+TEST_F(ScopedSymbolIndexFixture, a_redefinition_in_the_same_scope_replaces_the_value)
+{
+    index.define_symbol(child, 0, 10);
+    index.define_symbol(child, 0, 20);
+
+    ASSERT_THAT(index.get_symbol_value(grandchild, 0), Eq(std::make_tuple(true, 20)));
+}
+
+TEST_F(ScopedSymbolIndexFixture, resolves_a_symbol_defined_in_many_scopes)
+{
+    index.define_symbol(root, 0, -1);
+
+    std::vector<ScopedSymbolIndex::ScopePath> calls;
+    for (int call = 0; call < 10000; call += 1)
+    {
+        calls.push_back(index.open_scope(child));
+        index.define_symbol(calls.back(), 0, call);
+    }
+
+    for (int call = 0; call < 10000; call += 1)
+    {
+        const auto nested = index.open_scope(calls[call]);
+        ASSERT_THAT(index.get_symbol_value(nested, 0), Eq(std::make_tuple(true, call)));
+    }
+    ASSERT_THAT(index.get_symbol_value(child, 0), Eq(std::make_tuple(true, -1)));
+    ASSERT_THAT(index.get_symbol_value(sibling, 0), Eq(std::make_tuple(true, -1)));
+}
@@ -0,0 +1,61 @@
+#include "small_vector.h"
+
+#include "gmock/gmock.h"
+
+#include <string>
+
+using namespace testing;
+
+TEST(SmallVector, is_empty_when_created)
+{
+    SmallVector<int, 2> vector;
+
+    ASSERT_THAT(vector, IsEmpty());
+}
+
+TEST(SmallVector, keeps_the_elements_in_order)
+{
+    SmallVector<int, 2> vector{1, 2};
+    vector.push_back(3);
+    vector.push_back(4);
+
+    ASSERT_THAT(vector, ElementsAre(1, 2, 3, 4));
+    ASSERT_THAT(vector.front(), Eq(1));
+    ASSERT_THAT(vector.back(), Eq(4));
+}
+
+TEST(SmallVector, can_be_copied_inline_or_on_the_heap)
+{
+    SmallVector<std::string, 2> inline_vector{"a"};
+    SmallVector<std::string, 2> heap_vector{"a", "b", "c"};
+
+    const auto inline_copy = inline_vector;
+    const auto heap_copy = heap_vector;
+    inline_vector[0] = "changed";
+    heap_vector[0] = "changed";
+
+    ASSERT_THAT(inline_copy, ElementsAre("a"));
+    ASSERT_THAT(heap_copy, ElementsAre("a", "b", "c"));
+}
+
+TEST(SmallVector, is_empty_once_moved)
+{
+    SmallVector<std::string, 2> vector{"a", "b", "c"};
+
+    const auto moved = std::move(vector);
+
+    ASSERT_THAT(moved, ElementsAre("a", "b", "c"));
+    ASSERT_THAT(vector, IsEmpty());
+}
+
+TEST(SmallVector, moves_back_inline_when_popped)
+{
+    SmallVector<int, 2> vector{1, 2, 3};
+
+    vector.pop_back();
+    vector.push_back(4);
+    vector.pop_back();
+    vector.pop_back();
+
+    ASSERT_THAT(vector, ElementsAre(1));
+}
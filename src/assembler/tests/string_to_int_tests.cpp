@@ -0,0 +1,60 @@
+#include "evaluation/string_to_int.h"
+
+#include "evaluation/evaluate.h"
+
+#include "gmock/gmock.h"
+
+using namespace testing;
+
+TEST(StringToInt, reads_all_the_number_forms)
+{
+    ASSERT_THAT(string_to_int("1234", EvaluationFlags::None), Eq(1234));
+    ASSERT_THAT(string_to_int("0x1F", EvaluationFlags::None), Eq(31));
+    ASSERT_THAT(string_to_int("0FFh", EvaluationFlags::None), Eq(255));
+    ASSERT_THAT(string_to_int("17O", EvaluationFlags::None), Eq(15));
+    ASSERT_THAT(string_to_int("101b", EvaluationFlags::None), Eq(5));
+    ASSERT_THAT(string_to_int("'A'", EvaluationFlags::None), Eq(65));
+    ASSERT_THAT(string_to_int("100", EvaluationFlags::ThreeDigitsAsOctal), Eq(64));
+    ASSERT_THAT(string_to_int("1000", EvaluationFlags::ThreeDigitsAsOctal), Eq(1000));
+}
+
+TEST(StringToInt, reads_the_prefixes_strtol_accepts)
+{
+    ASSERT_THAT(string_to_int("0x1Fh", EvaluationFlags::None), Eq(31));
+    ASSERT_THAT(string_to_int("0x0x10", EvaluationFlags::None), Eq(16));
+    ASSERT_THAT(string_to_int("-12", EvaluationFlags::None), Eq(-12));
+    ASSERT_THAT(string_to_int("-2147483648", EvaluationFlags::None), Eq(-2147483648));
+}
+
+TEST(StringToInt, throws_on_invalid_numbers)
+{
+    ASSERT_THROW(string_to_int("79o", EvaluationFlags::None), InvalidNumber);
+    ASSERT_THROW(string_to_int("12a", EvaluationFlags::None), InvalidNumber);
+    ASSERT_THROW(string_to_int("0x", EvaluationFlags::None), InvalidNumber);
+    ASSERT_THROW(string_to_int("--1", EvaluationFlags::None), InvalidNumber);
+    ASSERT_THROW(string_to_int("", EvaluationFlags::None), InvalidNumber);
+}
+
+TEST(StringToInt, explains_why_a_number_is_invalid)
+{
+    try
+    {
+        std::ignore = string_to_int("0x1G", EvaluationFlags::None);
+        FAIL();
+    }
+    catch (const InvalidNumber& ex)
+    {
+        ASSERT_THAT(ex.what(), StrEq("Tried to read '1G' as hex. Argument is invalid"));
+    }
+
+    try
+    {
+        std::ignore = string_to_int("2147483648", EvaluationFlags::None);
+        FAIL();
+    }
+    catch (const InvalidNumber& ex)
+    {
+        ASSERT_THAT(ex.what(), StrEq("Tried to read '2147483648' as decimal. Argument is "
+                                     "out of range"));
+    }
+}
@@ -0,0 +1,52 @@
+#include "symbol_interner.h"
+
+#include "gmock/gmock.h"
+
+#include <string>
+
+using namespace testing;
+
+TEST(SymbolInterner, gives_dense_identifiers_in_interning_order)
+{
+    SymbolInterner interner;
+
+    ASSERT_THAT(interner.intern("start"), Eq(0));
+    ASSERT_THAT(interner.intern("loop"), Eq(1));
+    ASSERT_THAT(interner.size(), Eq(2));
+}
+
+TEST(SymbolInterner, gives_the_same_identifier_to_all_casings)
+{
+    SymbolInterner interner;
+    const auto id = interner.intern("Start");
+
+    ASSERT_THAT(interner.intern("START"), Eq(id));
+    ASSERT_THAT(interner.find("start"), Eq(id));
+    ASSERT_THAT(interner.get_name(id), Eq("START"));
+    ASSERT_THAT(interner.size(), Eq(1));
+}
+
+TEST(SymbolInterner, does_not_find_names_never_interned)
+{
+    SymbolInterner interner;
+    ASSERT_THAT(interner.find("start"), Eq(SymbolInterner::NO_SYMBOL));
+
+    interner.intern("start");
+    ASSERT_THAT(interner.find("star"), Eq(SymbolInterner::NO_SYMBOL));
+    ASSERT_THAT(interner.find("started"), Eq(SymbolInterner::NO_SYMBOL));
+}
+
+TEST(SymbolInterner, keeps_the_identifiers_when_growing)
+{
+    SymbolInterner interner;
+    for (int index = 0; index < 1000; index += 1)
+    {
+        interner.intern("label" + std::to_string(index));
+    }
+
+    ASSERT_THAT(interner.size(), Eq(1000));
+    for (int index = 0; index < 1000; index += 1)
+    {
+        ASSERT_THAT(interner.find("LABEL" + std::to_string(index)), Eq(index));
+    }
+}
@@ -0,0 +1,57 @@
+#include "symbol_table.h"
+
+#include "gmock/gmock.h"
+
+#include <sstream>
+
+using namespace testing;
+
+TEST(SymbolTable, finds_symbols_without_case)
+{
+    SymbolTable table;
+    table.define_symbol("Start", 0x100);
+
+    ASSERT_THAT(table.get_symbol_value("START"), Eq(std::make_tuple(true, 0x100)));
+    ASSERT_THAT(table.get_symbol_value("other"), Eq(std::make_tuple(false, 0)));
+}
+
+TEST(SymbolTable, finds_symbols_by_identifier)
+{
+    SymbolTable table;
+    const auto id = table.get_interner()->intern("start");
+    const auto other_id = table.get_interner()->intern("other");
+    table.define_symbol(id, "start", 12);
+
+    ASSERT_THAT(table.get_symbol_value(id), Eq(std::make_tuple(true, 12)));
+    ASSERT_THAT(table.get_symbol_value(other_id), Eq(std::make_tuple(false, 0)));
+}
+
+TEST(SymbolTable, shares_identifiers_with_the_same_interner)
+{
+    SymbolTable table;
+    SymbolTable other_table{table.get_interner()};
+    other_table.define_symbol("start", 12);
+
+    ASSERT_THAT(table.get_symbol_value("start"), Eq(std::make_tuple(false, 0)));
+    ASSERT_THAT(other_table.get_symbol_value(table.get_interner()->find("START")),
+                Eq(std::make_tuple(true, 12)));
+}
+
+TEST(SymbolTable, lists_symbols_in_definition_order_with_their_casing)
+{
+    SymbolTable table;
+    table.define_symbol("Start", 0x100);
+    table.define_symbol("value", 42);
+
+    const auto symbols = table.get_symbols();
+    ASSERT_THAT(symbols, SizeIs(2));
+    ASSERT_THAT(symbols[0].name, Eq("Start"));
+    ASSERT_THAT(symbols[0].value, Eq(0x100));
+    ASSERT_THAT(symbols[1].name, Eq("value"));
+    ASSERT_THAT(symbols[1].value, Eq(42));
+
+    std::stringstream listing;
+    table.list_symbols(listing);
+    ASSERT_THAT(listing.str(), HasSubstr("Symbol Count: 2"));
+    ASSERT_THAT(listing.str(), HasSubstr("     Start    1 000    256"));
+}
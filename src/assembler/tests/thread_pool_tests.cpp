@@ -0,0 +1,78 @@
+#include "thread_pool.h"
+
+#include "gmock/gmock.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace testing;
+
+TEST(ThreadPool, uses_hardware_threads_by_default)
+{
+    ThreadPool thread_pool{0};
+
+    ASSERT_THAT(thread_pool.get_thread_count(), Ge(1));
+}
+
+TEST(ThreadPool, runs_all_the_tasks_once)
+{
+    ThreadPool thread_pool{4};
+
+    std::vector<std::atomic<int>> counters(100);
+    std::vector<ThreadPool::Task> tasks;
+    for (auto& counter : counters)
+    {
+        tasks.emplace_back([&counter] { counter += 1; });
+    }
+    thread_pool.run(tasks);
+
+    for (const auto& counter : counters)
+    {
+        ASSERT_THAT(counter.load(), Eq(1));
+    }
+}
+
+TEST(ThreadPool, runs_tasks_in_order_with_one_thread)
+{
+    ThreadPool thread_pool{1};
+
+    std::vector<int> order;
+    std::vector<ThreadPool::Task> tasks;
+    for (int index = 0; index < 5; index += 1)
+    {
+        tasks.emplace_back([&order, index] { order.push_back(index); });
+    }
+    thread_pool.run(tasks);
+
+    ASSERT_THAT(order, ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(ThreadPool, throws_the_exception_of_the_first_failing_task)
+{
+    ThreadPool thread_pool{4};
+
+    std::atomic<int> run_count{0};
+    std::vector<ThreadPool::Task> tasks;
+    for (int index = 0; index < 20; index += 1)
+    {
+        tasks.emplace_back([&run_count, index] {
+            run_count += 1;
+            if (index == 7 || index == 15)
+            {
+                throw std::runtime_error(std::to_string(index));
+            }
+        });
+    }
+
+    try
+    {
+        thread_pool.run(tasks);
+        FAIL() << "an exception was expected";
+    }
+    catch (const std::runtime_error& ex)
+    {
+        ASSERT_THAT(ex.what(), StrEq("7"));
+    }
+    ASSERT_THAT(run_count.load(), Eq(20));
+}
@@ -1,12 +1,9 @@
+#include "assembler/src/assemble.h"
+#include "assembler/src/batch.h"
 #include "assembler/src/errors.h"
 #include "assembler/src/files/files.h"
-#include "assembler/src/first_pass.h"
-#include "assembler/src/listing.h"
-#include "assembler/src/listing_pass.h"
 #include "assembler/src/options.h"
-#include "assembler/src/parsed_line_storage.h"
-#include "assembler/src/second_pass.h"
-#include "context_stack.h"
+#include "server.h"
 
 #include <iostream>
 
@@ -23,24 +20,36 @@ int main(int argc, const char** argv)
         exit(-1);
     }
 
-    try
+    if (!global_options.server_socket_name.empty())
     {
-        Files files(global_options);
-        Listing listing(files.listing_stream, global_options);
-        ParsedLineStorage parsed_line_storage;
-
-        ContextStack context_stack(global_options);
-        auto top_level_context = context_stack.get_current_context();
-
-        first_pass(context_stack, files.file_reader, parsed_line_storage);
-        second_pass(global_options, files.output_stream, parsed_line_storage);
-        listing_pass(global_options, parsed_line_storage, listing);
+        return run_server(global_options);
+    }
 
-        /* write symbol table to listfile */
-        if (global_options.generate_list_file)
+    if (!global_options.batch_filename.empty())
+    {
+        try
+        {
+            const auto jobs = read_batch_jobs(global_options);
+            if (assemble_batch(jobs, global_options.thread_count) > 0)
+            {
+                exit(-1);
+            }
+        }
+        catch (const CannotOpenFile& ex)
         {
-            top_level_context->list_symbols(files.listing_stream);
+            std::cerr << ex.what() << std::endl;
+            exit(-1);
         }
+        catch (InvalidCommandLine&)
+        {
+            exit(-1);
+        }
+        return 0;
+    }
+
+    try
+    {
+        assemble_files(global_options);
     }
     catch (const CannotOpenFile& ex)
     {
@@ -0,0 +1,502 @@
+#include "server.h"
+
+#include "assembler/src/assemble.h"
+#include "assembler/src/errors.h"
+#include "assembler/src/files/file_cache.h"
+#include "assembler/src/files/file_reader.h"
+#include "assembler/src/files/file_utility.h"
+#include "assembler/src/files/files.h"
+#include "assembler/src/files/source_buffer.h"
+#include "assembler/src/options.h"
+
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    // Protects the server from requests announcing huge payloads.
+    constexpr std::size_t MAX_PAYLOAD_SIZE = 64 * 1024 * 1024;
+
+    // A connection without any request for this long is closed, and the clients connect again.
+    constexpr std::chrono::seconds IDLE_TIMEOUT{60};
+
+    // How often the waits for data or connections check whether the server is stopping.
+    constexpr std::chrono::milliseconds POLL_INTERVAL{200};
+
+    // Waits until the socket has data to read. Returns false when the server is stopping, or
+    // when the timeout is reached first.
+    bool wait_readable(int socket, const std::atomic<bool>& stopping,
+                       std::chrono::milliseconds timeout)
+    {
+        for (std::chrono::milliseconds waited{0}; waited < timeout; waited += POLL_INTERVAL)
+        {
+            if (stopping)
+            {
+                return false;
+            }
+            pollfd descriptor{socket, POLLIN, 0};
+            const auto ready = ::poll(&descriptor, 1, static_cast<int>(POLL_INTERVAL.count()));
+            if (ready > 0)
+            {
+                return true;
+            }
+            if (ready < 0 && errno != EINTR)
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    class Connection
+    {
+    public:
+        Connection(int socket, const std::atomic<bool>& stopping)
+            : socket{socket}, stopping{stopping}
+        {
+        }
+        Connection(const Connection&) = delete;
+        Connection& operator=(const Connection&) = delete;
+        ~Connection() { ::close(socket); }
+
+        // Reads a line, without its end. Returns false when the connection is closed.
+        bool read_line(std::string& line)
+        {
+            line.clear();
+            for (;;)
+            {
+                if (auto end_of_line = pending.find('\n'); end_of_line != std::string::npos)
+                {
+                    line = pending.substr(0, end_of_line);
+                    pending.erase(0, end_of_line + 1);
+                    return true;
+                }
+                if (pending.size() > MAX_PAYLOAD_SIZE || !receive())
+                {
+                    return false;
+                }
+            }
+        }
+
+        // Reads exactly size bytes. Returns false when the connection is closed.
+        bool read_bytes(std::size_t size, std::string& bytes)
+        {
+            while (pending.size() < size)
+            {
+                if (!receive())
+                {
+                    return false;
+                }
+            }
+            bytes = pending.substr(0, size);
+            pending.erase(0, size);
+            return true;
+        }
+
+        bool write(std::string_view data)
+        {
+            while (!data.empty())
+            {
+                const auto written = ::write(socket, data.data(), data.size());
+                if (written < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (written <= 0)
+                {
+                    return false;
+                }
+                data.remove_prefix(static_cast<std::size_t>(written));
+            }
+            return true;
+        }
+
+    private:
+        bool receive()
+        {
+            char buffer[4096];
+            for (;;)
+            {
+                if (!wait_readable(socket, stopping, IDLE_TIMEOUT))
+                {
+                    return false;
+                }
+                const auto received = ::read(socket, buffer, sizeof(buffer));
+                if (received < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (received <= 0)
+                {
+                    return false;
+                }
+                pending.append(buffer, static_cast<std::size_t>(received));
+                return true;
+            }
+        }
+
+        int socket;
+        const std::atomic<bool>& stopping;
+        std::string pending;
+    };
+
+    struct Request
+    {
+        std::vector<std::string> arguments;
+        std::vector<std::pair<std::string, std::string>> buffers;
+    };
+
+    struct Response
+    {
+        bool success{false};
+        std::string output;
+        std::string listing;
+        std::string diagnostics;
+    };
+
+    // Redirects the standard error, where warnings are written, during a request.
+    class DiagnosticsCapture
+    {
+    public:
+        explicit DiagnosticsCapture(std::ostringstream& diagnostics)
+            : previous_buffer{std::cerr.rdbuf(diagnostics.rdbuf())}
+        {}
+        DiagnosticsCapture(const DiagnosticsCapture&) = delete;
+        DiagnosticsCapture& operator=(const DiagnosticsCapture&) = delete;
+        ~DiagnosticsCapture() { std::cerr.rdbuf(previous_buffer); }
+
+    private:
+        std::streambuf* previous_buffer;
+    };
+
+    Response assemble_request(const Options& server_options, const Request& request)
+    {
+        Response response;
+        std::ostringstream diagnostics;
+        std::ostringstream output_stream;
+        std::ostringstream listing_stream;
+
+        {
+            DiagnosticsCapture capture{diagnostics};
+            try
+            {
+                Options options{server_options};
+                const std::vector<std::string_view> arguments{std::begin(request.arguments),
+                                                              std::end(request.arguments)};
+                options.parse_job(arguments);
+
+                // The buffers of the request can be included by name, before the files.
+                FileReader file_reader;
+                file_reader.set_include_resolver(
+                        [&request](const std::string& filename)
+                        {
+                            for (const auto& [name, content] : request.buffers)
+                            {
+                                if (name == filename)
+                                {
+                                    return SourceBuffer::from_string(content);
+                                }
+                            }
+                            return FileCache::global().get(filename);
+                        });
+                for (const auto& input_filename : options.input_filenames)
+                {
+                    Utility::append_file_by_name(file_reader, input_filename);
+                }
+                for (const auto& [name, content] : request.buffers)
+                {
+                    file_reader.append(SourceBuffer::from_string(content), name);
+                    options.input_filenames.push_back(name);
+                }
+                if (options.input_filenames.empty())
+                {
+                    std::cerr << "a request needs input files or buffers\n";
+                    throw InvalidCommandLine();
+                }
+
+                assemble_to_streams(options, file_reader, output_stream, listing_stream);
+                response.success = true;
+            }
+            catch (const InvalidCommandLine&)
+            {
+            }
+            catch (const CannotOpenFile& ex)
+            {
+                std::cerr << ex.what() << std::endl;
+            }
+            catch (const std::exception& ex)
+            {
+                std::cerr << "Error: " << ex.what() << std::endl;
+            }
+        }
+
+        if (response.success)
+        {
+            response.output = std::move(output_stream).str();
+            response.listing = std::move(listing_stream).str();
+        }
+        response.diagnostics = std::move(diagnostics).str();
+        return response;
+    }
+
+    bool write_response(Connection& connection, const Response& response)
+    {
+        auto write_section = [&connection](std::string_view name, const std::string& content) {
+            return connection.write(std::string{name} + " " + std::to_string(content.size()) +
+                                    "\n") &&
+                   connection.write(content);
+        };
+
+        return connection.write(response.success ? "STATUS OK\n" : "STATUS ERROR\n") &&
+               write_section("OUTPUT", response.output) &&
+               write_section("LISTING", response.listing) &&
+               write_section("DIAGNOSTICS", response.diagnostics);
+    }
+
+    bool parse_size(std::string_view text, std::size_t& size)
+    {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), size);
+        return error == std::errc{} && end == text.data() + text.size() &&
+               size <= MAX_PAYLOAD_SIZE;
+    }
+
+    // Serves the requests of a connection. Returns true when the server must stop.
+    // The assemblies are run one at a time, under the assembly mutex, as the standard error
+    // is captured for the request being assembled.
+    bool serve_connection(const Options& options, std::mutex& assembly_mutex,
+                          Connection& connection)
+    {
+        Request request;
+        std::string line;
+        while (connection.read_line(line))
+        {
+            std::string_view command{line};
+            if (command.starts_with("ARG "))
+            {
+                request.arguments.emplace_back(command.substr(4));
+            }
+            else if (command.starts_with("BUFFER "))
+            {
+                // The size is after the name, which may contain spaces.
+                const auto name_and_size = command.substr(7);
+                const auto last_space = name_and_size.rfind(' ');
+                std::size_t size{};
+                std::string content;
+                if (last_space == std::string_view::npos ||
+                    !parse_size(name_and_size.substr(last_space + 1), size) ||
+                    !connection.read_bytes(size, content))
+                {
+                    return false;
+                }
+                request.buffers.emplace_back(name_and_size.substr(0, last_space),
+                                             std::move(content));
+            }
+            else if (command == "END")
+            {
+                Response response;
+                {
+                    std::lock_guard lock{assembly_mutex};
+                    response = assemble_request(options, request);
+                }
+                if (!write_response(connection, response))
+                {
+                    return false;
+                }
+                request = {};
+            }
+            else if (command == "SHUTDOWN")
+            {
+                return true;
+            }
+            else
+            {
+                Response response;
+                response.diagnostics = "unknown request line: " + line + "\n";
+                if (!write_response(connection, response))
+                {
+                    return false;
+                }
+                request = {};
+            }
+        }
+        return false;
+    }
+
+    int open_server_socket(const std::string& socket_name)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socket_name.size() >= sizeof(address.sun_path))
+        {
+            std::cerr << "the socket name " << socket_name << " is too long" << std::endl;
+            return -1;
+        }
+        std::memcpy(address.sun_path, socket_name.c_str(), socket_name.size() + 1);
+
+        // A socket left by a previous server is replaced.
+        struct stat file_status{};
+        if (::stat(socket_name.c_str(), &file_status) == 0 && S_ISSOCK(file_status.st_mode))
+        {
+            ::unlink(socket_name.c_str());
+        }
+
+        const int server_socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (server_socket < 0)
+        {
+            std::cerr << "cannot create a socket: " << std::strerror(errno) << std::endl;
+            return -1;
+        }
+        if (::bind(server_socket, reinterpret_cast<const sockaddr*>(&address),
+                   sizeof(address)) < 0 ||
+            ::listen(server_socket, 8) < 0)
+        {
+            std::cerr << "cannot listen on " << socket_name << ": " << std::strerror(errno)
+                      << std::endl;
+            ::close(server_socket);
+            return -1;
+        }
+        return server_socket;
+    }
+
+    // Serves each connection on its own thread, so that a client keeping its connection open
+    // doesn't hold the others.
+    class Server
+    {
+    public:
+        explicit Server(const Options& options) : options{options} {}
+
+        void start_connection(int client_socket)
+        {
+            {
+                std::lock_guard lock{mutex};
+                open_connections += 1;
+            }
+            try
+            {
+                std::thread{[this, client_socket] { serve(client_socket); }}.detach();
+            }
+            catch (const std::system_error& ex)
+            {
+                std::cerr << "cannot serve a connection: " << ex.what() << std::endl;
+                ::close(client_socket);
+                close_connection();
+            }
+        }
+
+        // Waits until all the connections are closed.
+        void wait_for_connections()
+        {
+            std::unique_lock lock{mutex};
+            all_closed.wait(lock, [this] { return open_connections == 0; });
+        }
+
+        [[nodiscard]] const std::atomic<bool>& get_stopping() const { return stopping; }
+        void stop() { stopping = true; }
+
+    private:
+        void serve(int client_socket)
+        {
+            {
+                Connection connection{client_socket, stopping};
+                if (serve_connection(options, assembly_mutex, connection))
+                {
+                    stop();
+                }
+            }
+            close_connection();
+        }
+
+        void close_connection()
+        {
+            std::lock_guard lock{mutex};
+            open_connections -= 1;
+            all_closed.notify_all();
+        }
+
+        const Options& options;
+        std::atomic<bool> stopping{false};
+        std::mutex assembly_mutex;
+
+        std::mutex mutex;
+        std::condition_variable all_closed;
+        std::size_t open_connections{0};
+    };
+}
+
+int run_server(const Options& options)
+{
+    // A client closing its connection early must not stop the server.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    // The cached files outlive the requests. A client may rewrite or truncate its files
+    // between requests, and reading a mapping of a truncated file would kill the server.
+    FileCache::global().set_storage(FileCache::Storage::COPIED);
+
+    const int server_socket = open_server_socket(options.server_socket_name);
+    if (server_socket < 0)
+    {
+        return -1;
+    }
+
+    Server server{options};
+    int exit_code = 0;
+    while (!server.get_stopping())
+    {
+        if (!wait_readable(server_socket, server.get_stopping(), POLL_INTERVAL))
+        {
+            continue;
+        }
+        const int client_socket = ::accept(server_socket, nullptr, nullptr);
+        if (client_socket < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            std::cerr << "cannot accept a connection: " << std::strerror(errno) << std::endl;
+            exit_code = -1;
+            server.stop();
+            break;
+        }
+        server.start_connection(client_socket);
+    }
+    server.wait_for_connections();
+
+    ::close(server_socket);
+    ::unlink(options.server_socket_name.c_str());
+    return exit_code;
+}
+
+#else
+
+int run_server(const Options& options)
+{
+    std::cerr << "the server mode is not available on this platform" << std::endl;
+    return -1;
+}
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef INC_8008_ASSEMBLER_SERVER_H
+#define INC_8008_ASSEMBLER_SERVER_H
+
+class Options;
+
+// Serves assembly requests on a local socket, until a SHUTDOWN request is received.
+// The options of the server are the defaults of each request.
+// Returns the exit code of the program.
+int run_server(const Options& options);
+
+#endif //INC_8008_ASSEMBLER_SERVER_H
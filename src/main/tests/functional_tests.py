@@ -19,6 +19,23 @@ def run_assembler(arg_list=None):
     return result
 
 
+def read_server_response(connection):
+    reader = connection.makefile("rb")
+    status = reader.readline().decode().strip()
+    sections = {}
+    for _ in range(3):
+        name, size = reader.readline().decode().split()
+        sections[name] = reader.read(int(size))
+    return status, sections
+
+
+def text_equal_to_file(ref_file, content):
+    with open(ref_file, "rt") as ref_f:
+        ref_lines = [line for line in ref_f.readlines() if ASSEMBLY_TEXT not in line]
+        lines = [line + "\n" for line in content.split("\n") if ASSEMBLY_TEXT not in line]
+        return ref_lines == lines[:-1]
+
+
 def file_equal(ref_file, file_):
     with open(file_, "rt") as f:
         with open(ref_file, "rt") as ref_f:
@@ -77,6 +94,9 @@ help_output = """    where <infile> is assembly code file, extension defaults to
     -markascii  makes highest bit in ascii bytes a one (mark).
     -syntax=new default parsing is with new syntax mnemonics.
     -o          the next argument is the output filename base.
+    -batch      the next argument is a file listing jobs to assemble.
+    -threads    the next argument is the number of threads to assemble with.
+    --serve     the next argument is the socket of an assembler server.
 """
 
 ASSEMBLY_TEXT = "Assembly Performed"
@@ -372,3 +392,65 @@ class TestFunctional(unittest.TestCase):
 
             self.assertTrue(file_equal_binary(files.output_bin_double_ref_file, files.output_double_bin_file),
                             msg=f"File differs {files.output_double_bin_file}")
+
+    @unittest.skipUnless(hasattr(__import__("socket"), "AF_UNIX"), "needs local sockets")
+    def test_serve_assembles_files_and_buffers(self):
+        import socket
+        import subprocess
+        import tempfile
+        import time
+
+        files = DataFiles()
+
+        with tempfile.TemporaryDirectory() as temp_dir:
+            socket_path = pathlib.Path(temp_dir).joinpath("as-8008.sock")
+            server = subprocess.Popen([assembler_path, "--serve", socket_path],
+                                      stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+            try:
+                for _ in range(100):
+                    if socket_path.exists():
+                        break
+                    time.sleep(0.05)
+
+                with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as idle_connection, \
+                        socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as connection:
+                    # A client keeping its connection open doesn't hold the others.
+                    idle_connection.connect(str(socket_path))
+                    connection.connect(str(socket_path))
+
+                    connection.sendall(f"ARG -as8\nARG {files.input_file}\nEND\n".encode())
+                    status, sections = read_server_response(connection)
+
+                    self.assertEqual(status, "STATUS OK")
+                    self.assertEqual(sections["DIAGNOSTICS"], b"")
+                    self.assertTrue(text_equal_to_file(files.output_hex_ref_file, sections["OUTPUT"].decode()))
+                    self.assertTrue(text_equal_to_file(files.output_lst_ref_file, sections["LISTING"].decode()))
+
+                    source = b"        LAI 1\n        JMP nowhere\n"
+                    connection.sendall(b"ARG -nl\nBUFFER snippet.asm " + str(len(source)).encode() + b"\n" +
+                                       source + b"END\n")
+                    status, sections = read_server_response(connection)
+
+                    self.assertEqual(status, "STATUS ERROR")
+                    self.assertIn(b"cannot find symbol nowhere", sections["DIAGNOSTICS"])
+                    self.assertIn(b"snippet.asm", sections["DIAGNOSTICS"])
+
+                    # The buffers of a request can be included by their name.
+                    source = b"        .include regs.inc\n"
+                    included = b"        LAI 42\n"
+                    connection.sendall(b"ARG -nl\nBUFFER regs.inc " + str(len(included)).encode() + b"\n" +
+                                       included + b"BUFFER main.asm " + str(len(source)).encode() + b"\n" +
+                                       source + b"END\n")
+                    status, sections = read_server_response(connection)
+
+                    self.assertEqual(status, "STATUS OK", msg=sections["DIAGNOSTICS"])
+                    self.assertEqual(sections["OUTPUT"].count(b"062A"), 2, msg=sections["OUTPUT"])
+
+                    connection.sendall(b"SHUTDOWN\n")
+
+                self.assertEqual(server.wait(timeout=10), 0)
+                self.assertFalse(socket_path.exists())
+            finally:
+                if server.poll() is None:
+                    server.kill()
+                    server.wait()